@@ -337,6 +337,23 @@ std::string Filesystem::readFile(const std::filesystem::path& filename) const
 }
 
 
+/**
+ * Maps a file into memory, instead of reading it into a buffer.
+ *
+ * \param	filename	Path of the file to map relative to the Filesystem root directory.
+ */
+MappedFile Filesystem::mapFile(const std::filesystem::path& filename) const
+{
+	const auto& filePath = findFirstPath(filename, mSearchPaths);
+	if (filePath.empty())
+	{
+		throw std::runtime_error("Error opening file: " + filename.string() + " : File does not exist");
+	}
+
+	return MappedFile{filePath};
+}
+
+
 void Filesystem::writeFile(const std::filesystem::path& filename, const std::string& data, WriteFlags flags)
 {
 	if (flags != WriteFlags::Overwrite && exists(filename))
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include "MappedFile.h"
+
 #include <vector>
 #include <string>
 #include <string_view>
@@ -57,6 +59,7 @@ namespace NAS2D
 		void del(const std::filesystem::path& path);
 
 		std::string readFile(const std::filesystem::path& filename) const;
+		MappedFile mapFile(const std::filesystem::path& filename) const;
 		void writeFile(const std::filesystem::path& filename, const std::string& data, WriteFlags flags = WriteFlags::Overwrite);
 
 	private:
@@ -0,0 +1,104 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "FixedTimestep.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+
+using namespace NAS2D;
+
+
+/**
+ * \param	step				Simulated time per step.
+ * \param	maxStepsPerFrame	Most steps run for one frame, beyond which time is dropped.
+ */
+FixedTimestep::FixedTimestep(std::chrono::microseconds step, unsigned int maxStepsPerFrame) :
+	mStep{step},
+	mMaxStepsPerFrame{maxStepsPerFrame}
+{
+	if (step <= std::chrono::microseconds::zero() || maxStepsPerFrame == 0)
+	{
+		throw std::runtime_error("FixedTimestep requires a positive step and step limit: " + std::to_string(step.count()) + " us, " + std::to_string(maxStepsPerFrame) + " steps");
+	}
+}
+
+
+std::chrono::microseconds FixedTimestep::step() const
+{
+	return mStep;
+}
+
+
+/**
+ * Step length in seconds, as passed to State::fixedUpdate().
+ */
+float FixedTimestep::stepSeconds() const
+{
+	return std::chrono::duration<float>{mStep}.count();
+}
+
+
+unsigned int FixedTimestep::maxStepsPerFrame() const
+{
+	return mMaxStepsPerFrame;
+}
+
+
+/**
+ * Adds the real time of a frame, and returns how many steps to simulate for it.
+ */
+unsigned int FixedTimestep::advance(std::chrono::nanoseconds elapsed)
+{
+	mAccumulator += std::max(elapsed, std::chrono::nanoseconds::zero());
+
+	const auto stepCount = mAccumulator / mStep;
+	mAccumulator -= stepCount * mStep;
+
+	const auto maxStepCount = static_cast<std::chrono::nanoseconds::rep>(mMaxStepsPerFrame);
+	if (stepCount > maxStepCount)
+	{
+		mDroppedTime += (stepCount - maxStepCount) * mStep;
+		return mMaxStepsPerFrame;
+	}
+	return static_cast<unsigned int>(stepCount);
+}
+
+
+/**
+ * Fraction of a step carried over to the next frame, from 0 up to but not including 1.
+ *
+ * Draw positions as previous + (current - previous) * interpolation() to hide
+ * the difference between the step rate and the frame rate.
+ */
+float FixedTimestep::interpolation() const
+{
+	return std::chrono::duration<float>{mAccumulator} / std::chrono::duration<float>{mStep};
+}
+
+
+/**
+ * Total real time not simulated, because too many steps were due in a frame.
+ */
+std::chrono::nanoseconds FixedTimestep::droppedTime() const
+{
+	return mDroppedTime;
+}
+
+
+/**
+ * Discards carried over time, such as after loading, so the next frame doesn't catch up on it.
+ */
+void FixedTimestep::reset()
+{
+	mAccumulator = std::chrono::nanoseconds::zero();
+}
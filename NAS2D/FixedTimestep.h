@@ -0,0 +1,55 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include <chrono>
+
+
+namespace NAS2D
+{
+
+	/**
+	 * Divides elapsed time into simulation steps of a fixed length.
+	 *
+	 * Time that doesn't fill a whole step carries over to the next frame, and
+	 * its fraction of a step is the interpolation for drawing between the last
+	 * two simulated states.
+	 *
+	 * If the simulation falls too far behind, such as after a stall or when
+	 * each step costs more than a step of real time, steps past the per frame
+	 * limit are dropped. The simulation then runs slow, rather than each frame
+	 * falling further behind than the last.
+	 */
+	class FixedTimestep
+	{
+	public:
+		static constexpr unsigned int DefaultMaxStepsPerFrame{5};
+
+		explicit FixedTimestep(std::chrono::microseconds step, unsigned int maxStepsPerFrame = DefaultMaxStepsPerFrame);
+
+		std::chrono::microseconds step() const;
+		float stepSeconds() const;
+		unsigned int maxStepsPerFrame() const;
+
+		unsigned int advance(std::chrono::nanoseconds elapsed);
+		float interpolation() const;
+		std::chrono::nanoseconds droppedTime() const;
+
+		void reset();
+
+	private:
+		std::chrono::microseconds mStep;
+		unsigned int mMaxStepsPerFrame;
+		std::chrono::nanoseconds mAccumulator{0};
+		std::chrono::nanoseconds mDroppedTime{0};
+	};
+
+} // namespace
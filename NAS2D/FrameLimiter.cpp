@@ -0,0 +1,140 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "FrameLimiter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+
+using namespace NAS2D;
+
+
+namespace
+{
+	constexpr std::chrono::milliseconds SleepStep{1};
+	// Assumed length of a sleep step until some have been measured
+	constexpr FrameLimiter::Milliseconds InitialSleepEstimate{2.0};
+}
+
+
+/**
+ * \param	targetFps	Frames per second to limit to, or 0 for no limit.
+ */
+FrameLimiter::FrameLimiter(unsigned int targetFps)
+{
+	setTargetFps(targetFps);
+}
+
+
+/**
+ * Sets the frames per second to limit to, or 0 for no limit.
+ */
+void FrameLimiter::setTargetFps(unsigned int targetFps)
+{
+	mTargetFps = targetFps;
+	mFramePeriod = targetFps > 0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::seconds{1}) / targetFps : Clock::duration::zero();
+	mDeadline.reset();
+}
+
+
+unsigned int FrameLimiter::targetFps() const
+{
+	return mTargetFps;
+}
+
+
+/**
+ * Waits for the end of the current frame. Call once per frame, after presenting it.
+ *
+ * Without a target, returns immediately, and only measures frame time.
+ */
+void FrameLimiter::wait()
+{
+	if (mTargetFps > 0)
+	{
+		if (mDeadline)
+		{
+			sleepUntil(*mDeadline);
+		}
+
+		const auto now = Clock::now();
+		mDeadline = (mDeadline && now - *mDeadline < mFramePeriod) ? *mDeadline + mFramePeriod : now + mFramePeriod;
+	}
+
+	const auto frameEnd = Clock::now();
+	if (mLastFrameEnd)
+	{
+		mFrameStats.add(Milliseconds{frameEnd - *mLastFrameEnd}.count());
+	}
+	mLastFrameEnd = frameEnd;
+}
+
+
+FrameLimiter::FrameTimeStats FrameLimiter::frameTimeStats() const
+{
+	return {
+		mFrameStats.count,
+		Milliseconds{mFrameStats.mean},
+		Milliseconds{mFrameStats.standardDeviation()},
+		Milliseconds{mFrameStats.maximum},
+	};
+}
+
+
+/**
+ * Starts measuring frame time afresh, such as after loading a level.
+ */
+void FrameLimiter::resetFrameTimeStats()
+{
+	mFrameStats = {};
+	mLastFrameEnd.reset();
+}
+
+
+void FrameLimiter::sleepUntil(Clock::time_point deadline)
+{
+	while (true)
+	{
+		const auto sleepEstimate = mSleepStats.count < 2 ? InitialSleepEstimate : Milliseconds{mSleepStats.mean + mSleepStats.standardDeviation()};
+		const auto start = Clock::now();
+		if (deadline - start <= sleepEstimate)
+		{
+			break;
+		}
+
+		std::this_thread::sleep_for(SleepStep);
+		mSleepStats.add(Milliseconds{Clock::now() - start}.count());
+	}
+
+	// Sleeping can't end precisely, so spin for the remainder
+	while (Clock::now() < deadline)
+	{
+		std::this_thread::yield();
+	}
+}
+
+
+void FrameLimiter::RunningStats::add(double value)
+{
+	// Welford's method, which stays accurate over long runs
+	++count;
+	const auto delta = value - mean;
+	mean += delta / static_cast<double>(count);
+	sumSquaredDeviations += delta * (value - mean);
+	maximum = std::max(maximum, value);
+}
+
+
+double FrameLimiter::RunningStats::standardDeviation() const
+{
+	return count > 1 ? std::sqrt(sumSquaredDeviations / static_cast<double>(count - 1)) : 0.0;
+}
@@ -0,0 +1,82 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
+
+namespace NAS2D
+{
+
+	/**
+	 * Limits the frame rate of a loop, and measures how evenly frames are paced.
+	 *
+	 * Waits sleep in short steps while there is clearly time for another step,
+	 * then spin for the remainder, so frames end within a fraction of a
+	 * millisecond of their deadline without keeping a core busy. Step lengths
+	 * are measured as they happen, since the sleep resolution of the system
+	 * isn't known in advance.
+	 *
+	 * A frame that runs over its deadline by more than a whole frame doesn't
+	 * make later frames hurry to catch up.
+	 */
+	class FrameLimiter
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+		using Milliseconds = std::chrono::duration<double, std::milli>;
+
+		// Time between frames, measured at the end of each wait()
+		struct FrameTimeStats
+		{
+			std::size_t frameCount;
+			Milliseconds average;
+			// Standard deviation of frame time
+			Milliseconds jitter;
+			Milliseconds maximum;
+		};
+
+		explicit FrameLimiter(unsigned int targetFps = 0);
+
+		void setTargetFps(unsigned int targetFps);
+		unsigned int targetFps() const;
+
+		void wait();
+
+		FrameTimeStats frameTimeStats() const;
+		void resetFrameTimeStats();
+
+	private:
+		struct RunningStats
+		{
+			std::size_t count{0};
+			double mean{0.0};
+			double sumSquaredDeviations{0.0};
+			double maximum{0.0};
+
+			void add(double value);
+			double standardDeviation() const;
+		};
+
+		void sleepUntil(Clock::time_point deadline);
+
+		unsigned int mTargetFps{0};
+		Clock::duration mFramePeriod{};
+		std::optional<Clock::time_point> mDeadline{};
+		std::optional<Clock::time_point> mLastFrameEnd{};
+		// Milliseconds, of sleeps and of frames
+		RunningStats mSleepStats{};
+		RunningStats mFrameStats{};
+	};
+
+} // namespace
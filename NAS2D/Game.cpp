@@ -23,6 +23,7 @@
 
 #include <SDL2/SDL.h>
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 
@@ -58,6 +59,8 @@ Game::Game(const std::string& title, const std::string& appName, const std::stri
 					{"bitdepth", 32},
 					{"fullscreen", false},
 					{"vsync", true},
+					{"adaptivevsync", false},
+					{"fpslimit", 0},
 				}},
 			},
 			{
@@ -75,6 +78,8 @@ Game::Game(const std::string& title, const std::string& appName, const std::stri
 	);
 	cf.load(configPath);
 
+	mFrameLimiter.setTargetFps(static_cast<unsigned int>(std::max(cf["graphics"].get<int>("fpslimit"), 0)));
+
 	try
 	{
 		Utility<Mixer>::init<MixerSDL>();
@@ -119,6 +124,28 @@ void Game::mount(const std::string& path)
 }
 
 
+/**
+ * Limits the frame rate of go(), and measures frame pacing.
+ *
+ * Starts with the target from the "fpslimit" graphics setting, where 0 means no limit.
+ */
+FrameLimiter& Game::frameLimiter()
+{
+	return mFrameLimiter;
+}
+
+
+/**
+ * Makes go() run the simulation of states in fixed steps, through State::fixedUpdate().
+ *
+ * \see StateManager::setFixedTimestep
+ */
+void Game::setFixedTimestep(std::chrono::microseconds step, unsigned int maxStepsPerFrame)
+{
+	mFixedTimestep.emplace(step, maxStepsPerFrame);
+}
+
+
 /**
  * Primes the EventHandler and StateManager and enters the main game loop.
  *
@@ -131,11 +158,17 @@ void Game::go(State* state)
 {
 	StateManager stateManager;
 
+	if (mFixedTimestep)
+	{
+		stateManager.setFixedTimestep(mFixedTimestep->step(), mFixedTimestep->maxStepsPerFrame());
+	}
+
 	stateManager.setState(state);
 
 	// Game Loop
 	while (stateManager.update())
 	{
 		Utility<Renderer>::get().update();
+		mFrameLimiter.wait();
 	}
 }
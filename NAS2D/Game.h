@@ -10,6 +10,11 @@
 
 #pragma once
 
+#include "FixedTimestep.h"
+#include "FrameLimiter.h"
+
+#include <chrono>
+#include <optional>
 #include <string>
 
 
@@ -59,7 +64,15 @@ namespace NAS2D
 
 		void mount(const std::string& path);
 
+		FrameLimiter& frameLimiter();
+
+		void setFixedTimestep(std::chrono::microseconds step, unsigned int maxStepsPerFrame = FixedTimestep::DefaultMaxStepsPerFrame);
+
 		void go(State* state);
+
+	private:
+		FrameLimiter mFrameLimiter;
+		std::optional<FixedTimestep> mFixedTimestep;
 	};
 
 } // namespace
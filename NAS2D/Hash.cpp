@@ -0,0 +1,129 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "Hash.h"
+
+#include <bit>
+
+
+namespace
+{
+	constexpr uint64_t Prime1{0x9E3779B185EBCA87};
+	constexpr uint64_t Prime2{0xC2B2AE3D27D4EB4F};
+	constexpr uint64_t Prime3{0x165667B19E3779F9};
+	constexpr uint64_t Prime4{0x85EBCA77C2B2AE63};
+	constexpr uint64_t Prime5{0x27D4EB2F165667C5};
+
+
+	// Input is read as little endian, independent of the platform
+	uint64_t read64(const unsigned char* data)
+	{
+		uint64_t value = 0;
+		for (std::size_t i = 0; i < 8; ++i)
+		{
+			value |= uint64_t{data[i]} << (i * 8);
+		}
+		return value;
+	}
+
+
+	uint64_t read32(const unsigned char* data)
+	{
+		uint64_t value = 0;
+		for (std::size_t i = 0; i < 4; ++i)
+		{
+			value |= uint64_t{data[i]} << (i * 8);
+		}
+		return value;
+	}
+
+
+	uint64_t round(uint64_t accumulator, uint64_t input)
+	{
+		accumulator += input * Prime2;
+		accumulator = std::rotl(accumulator, 31);
+		return accumulator * Prime1;
+	}
+
+
+	uint64_t mergeRound(uint64_t accumulator, uint64_t value)
+	{
+		accumulator ^= round(0, value);
+		return accumulator * Prime1 + Prime4;
+	}
+}
+
+
+namespace NAS2D
+{
+	uint64_t xxHash64(const void* data, std::size_t size, uint64_t seed)
+	{
+		const auto* position = static_cast<const unsigned char*>(data);
+		const auto* const end = position + size;
+
+		uint64_t hash;
+		if (size >= 32)
+		{
+			uint64_t v1 = seed + Prime1 + Prime2;
+			uint64_t v2 = seed + Prime2;
+			uint64_t v3 = seed;
+			uint64_t v4 = seed - Prime1;
+
+			const auto* const limit = end - 32;
+			do
+			{
+				v1 = round(v1, read64(position));
+				v2 = round(v2, read64(position + 8));
+				v3 = round(v3, read64(position + 16));
+				v4 = round(v4, read64(position + 24));
+				position += 32;
+			} while (position <= limit);
+
+			hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+			hash = mergeRound(hash, v1);
+			hash = mergeRound(hash, v2);
+			hash = mergeRound(hash, v3);
+			hash = mergeRound(hash, v4);
+		}
+		else
+		{
+			hash = seed + Prime5;
+		}
+
+		hash += uint64_t{size};
+
+		for (; position + 8 <= end; position += 8)
+		{
+			hash ^= round(0, read64(position));
+			hash = std::rotl(hash, 27) * Prime1 + Prime4;
+		}
+
+		if (position + 4 <= end)
+		{
+			hash ^= read32(position) * Prime1;
+			hash = std::rotl(hash, 23) * Prime2 + Prime3;
+			position += 4;
+		}
+
+		for (; position < end; ++position)
+		{
+			hash ^= uint64_t{*position} * Prime5;
+			hash = std::rotl(hash, 11) * Prime1;
+		}
+
+		hash ^= hash >> 33;
+		hash *= Prime2;
+		hash ^= hash >> 29;
+		hash *= Prime3;
+		hash ^= hash >> 32;
+
+		return hash;
+	}
+}
@@ -0,0 +1,35 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+
+namespace NAS2D
+{
+	/**
+	 * Computes the 64 bit xxHash (XXH64) of a block of memory.
+	 *
+	 * Fast non-cryptographic hash, suitable for identifying file contents
+	 * in caches. Results match the reference implementation.
+	 *
+	 * \note	The seed is not defaulted for raw memory, so a string literal and
+	 *			seed can not be mistaken for a pointer and size.
+	 */
+	uint64_t xxHash64(const void* data, std::size_t size, uint64_t seed);
+
+	inline uint64_t xxHash64(std::string_view data, uint64_t seed = 0)
+	{
+		return xxHash64(data.data(), data.size(), seed);
+	}
+}
@@ -0,0 +1,147 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+
+using namespace NAS2D;
+
+
+namespace
+{
+	std::runtime_error mapError(const std::filesystem::path& filePath, const std::string& reason)
+	{
+		return std::runtime_error("Error mapping file: " + filePath.string() + " : " + reason);
+	}
+}
+
+
+/**
+ * \param	filePath	Path of the file to map, in the native filesystem.
+ *
+ * \throw	std::runtime_error if the file can't be opened or mapped, or is empty.
+ */
+MappedFile::MappedFile(const std::filesystem::path& filePath)
+{
+	std::error_code errorCode;
+	const auto fileSize = std::filesystem::file_size(filePath, errorCode);
+	if (errorCode)
+	{
+		throw mapError(filePath, errorCode.message());
+	}
+	// Zero length mappings are an error on all platforms
+	if (fileSize == 0)
+	{
+		throw mapError(filePath, "File is empty");
+	}
+	mSize = static_cast<std::size_t>(fileSize);
+
+#if defined(_WIN32)
+	const auto file = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		throw mapError(filePath, std::system_category().message(static_cast<int>(GetLastError())));
+	}
+	const auto mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping)
+	{
+		throw mapError(filePath, std::system_category().message(static_cast<int>(GetLastError())));
+	}
+	// The view keeps the mapping object alive
+	mData = static_cast<std::byte*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+	CloseHandle(mapping);
+	if (!mData)
+	{
+		throw mapError(filePath, std::system_category().message(static_cast<int>(GetLastError())));
+	}
+#else
+	const auto file = open(filePath.c_str(), O_RDONLY);
+	if (file == -1)
+	{
+		throw mapError(filePath, std::generic_category().message(errno));
+	}
+	auto* address = mmap(nullptr, mSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+	const auto mapErrno = errno;
+	close(file);
+	if (address == MAP_FAILED)
+	{
+		throw mapError(filePath, std::generic_category().message(mapErrno));
+	}
+	mData = static_cast<std::byte*>(address);
+#endif
+}
+
+
+MappedFile::MappedFile(MappedFile&& other) noexcept :
+	mData{std::exchange(other.mData, nullptr)},
+	mSize{std::exchange(other.mSize, 0)}
+{
+}
+
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		unmap();
+		mData = std::exchange(other.mData, nullptr);
+		mSize = std::exchange(other.mSize, 0);
+	}
+	return *this;
+}
+
+
+MappedFile::~MappedFile()
+{
+	unmap();
+}
+
+
+std::span<std::byte> MappedFile::data() const
+{
+	return {mData, mSize};
+}
+
+
+std::size_t MappedFile::size() const
+{
+	return mSize;
+}
+
+
+void MappedFile::unmap()
+{
+	if (!mData)
+	{
+		return;
+	}
+
+#if defined(_WIN32)
+	UnmapViewOfFile(mData);
+#else
+	munmap(mData, mSize);
+#endif
+	mData = nullptr;
+	mSize = 0;
+}
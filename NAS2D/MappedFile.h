@@ -0,0 +1,48 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+
+namespace NAS2D
+{
+	/**
+	 * Read only file contents, mapped into memory.
+	 *
+	 * Pages are loaded by the operating system as they are first accessed, and
+	 * the contents are never copied into a separate buffer.
+	 *
+	 * \note	The mapping is private copy-on-write. Writes to data() are allowed,
+	 *			but are never written back to the file.
+	 */
+	class MappedFile
+	{
+	public:
+		explicit MappedFile(const std::filesystem::path& filePath);
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+		~MappedFile();
+
+		std::span<std::byte> data() const;
+		std::size_t size() const;
+
+	private:
+		void unmap();
+
+		std::byte* mData{nullptr};
+		std::size_t mSize{0};
+	};
+}
@@ -0,0 +1,77 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "RectanglePacker.h"
+
+
+using namespace NAS2D;
+
+
+/**
+ * \param	size	Size of the area to pack items into.
+ * \param	padding	Space left between items, and between items and the top left edges.
+ */
+RectanglePacker::RectanglePacker(Vector<int> size, int padding) :
+	mSize{size},
+	mPadding{padding}
+{
+}
+
+
+/**
+ * Finds space for an item.
+ *
+ * \return	Position of the top left corner of the item, or an empty optional if it does not fit.
+ */
+std::optional<Point<int>> RectanglePacker::add(Vector<int> itemSize)
+{
+	const auto paddedSize = itemSize + Vector{mPadding, mPadding};
+
+	Shelf* bestShelf = nullptr;
+	for (auto& shelf : mShelves)
+	{
+		const auto fits = paddedSize.y <= shelf.height && shelf.usedWidth + paddedSize.x <= mSize.x;
+		if (fits && (!bestShelf || shelf.height < bestShelf->height))
+		{
+			bestShelf = &shelf;
+		}
+	}
+
+	if (!bestShelf)
+	{
+		if (mUsedHeight + paddedSize.y > mSize.y || paddedSize.x > mSize.x)
+		{
+			return {};
+		}
+
+		mShelves.push_back({mUsedHeight, paddedSize.y, 0});
+		mUsedHeight += paddedSize.y;
+		bestShelf = &mShelves.back();
+	}
+
+	const auto position = Point{bestShelf->usedWidth + mPadding, bestShelf->y + mPadding};
+	bestShelf->usedWidth += paddedSize.x;
+	return position;
+}
+
+
+Vector<int> RectanglePacker::size() const
+{
+	return mSize;
+}
+
+
+/**
+ * Height of the area covered by shelves so far.
+ */
+int RectanglePacker::usedHeight() const
+{
+	return mUsedHeight;
+}
@@ -0,0 +1,55 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include "Point.h"
+#include "Vector.h"
+
+#include <optional>
+#include <vector>
+
+
+namespace NAS2D
+{
+	/**
+	 * Packs rectangles into a fixed size area using horizontal shelves.
+	 *
+	 * Each item is placed on the shelf that fits it with the least wasted height,
+	 * and a new shelf is opened when none fit. Works well for items of similar
+	 * height, such as the glyphs of a font.
+	 *
+	 * \note	Items are separated by the padding amount, to prevent texture
+	 *			filtering from sampling neighbouring items.
+	 */
+	class RectanglePacker
+	{
+	public:
+		RectanglePacker(Vector<int> size, int padding = 0);
+
+		std::optional<Point<int>> add(Vector<int> itemSize);
+
+		Vector<int> size() const;
+		int usedHeight() const;
+
+	private:
+		struct Shelf
+		{
+			int y;
+			int height;
+			int usedWidth;
+		};
+
+		Vector<int> mSize;
+		int mPadding;
+		int mUsedHeight{0};
+		std::vector<Shelf> mShelves{};
+	};
+} // namespace NAS2D
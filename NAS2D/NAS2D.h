@@ -13,7 +13,9 @@
 #include "Dictionary.h"
 #include "EventHandler.h"
 #include "Filesystem.h"
+#include "FixedTimestep.h"
 #include "FpsCounter.h"
+#include "FrameLimiter.h"
 #include "Game.h"
 #include "State.h"
 #include "StateManager.h"
@@ -28,13 +30,20 @@
 
 #include "Mixer/Mixer.h"
 
+#include "Renderer/DrawList.h"
+#include "Renderer/PathMesh.h"
 #include "Renderer/Renderer.h"
+#include "Renderer/TextCache.h"
 
+#include "Resource/CollisionMask.h"
+#include "Resource/DynamicImage.h"
 #include "Resource/Font.h"
 #include "Resource/Image.h"
 #include "Resource/Music.h"
 #include "Resource/Sound.h"
 #include "Resource/Sprite.h"
+#include "Resource/TextureUploadQueue.h"
+#include "Resource/TiledTexture.h"
 
 #include "Signal/SignalConnection.h"
 #include "Signal/Delegate.h"
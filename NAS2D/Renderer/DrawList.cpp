@@ -0,0 +1,183 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "DrawList.h"
+
+#include "Renderer.h"
+#include "../Resource/Image.h"
+#include "../Resource/Sprite.h"
+#include "../Utility.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+
+using namespace NAS2D;
+
+
+namespace
+{
+	constexpr std::size_t DigitBits{8};
+	constexpr std::size_t DigitCount{64 / DigitBits};
+	constexpr std::size_t BucketCount{std::size_t{1} << DigitBits};
+
+
+	// Maps floats to unsigned integers with the same order, negatives included
+	uint32_t orderedBits(float value)
+	{
+		const auto bits = std::bit_cast<uint32_t>(value);
+		return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+	}
+
+
+	// Layer, then depth, then image group, from the most significant bits
+	uint64_t sortKey(int layer, float depth, uint16_t imageGroup)
+	{
+		const auto layerBits = static_cast<uint64_t>(layer - DrawList::MinLayer);
+		return layerBits << 48 | uint64_t{orderedBits(depth)} << 16 | imageGroup;
+	}
+}
+
+
+void DrawList::add(const Image& image, Point<float> position, int layer, float depth, Color color)
+{
+	push({&image, nullptr, position, {{0, 0}, image.size().to<float>()}, color}, image, layer, depth);
+}
+
+
+void DrawList::add(const Image& image, Point<float> position, const Rectangle<float>& subImageRect, int layer, float depth, Color color)
+{
+	push({&image, nullptr, position, subImageRect, color}, image, layer, depth);
+}
+
+
+/**
+ * Adds the current frame of a sprite.
+ *
+ * The sprite is drawn as it is at flush(), so it must outlive the call.
+ */
+void DrawList::add(const Sprite& sprite, Point<float> position, int layer, float depth)
+{
+	push({nullptr, &sprite, position, {}, Color::Normal}, sprite.currentFrame().image, layer, depth);
+}
+
+
+std::size_t DrawList::size() const
+{
+	return mCommands.size();
+}
+
+
+bool DrawList::empty() const
+{
+	return mCommands.empty();
+}
+
+
+void DrawList::clear()
+{
+	mCommands.clear();
+	mEntries.clear();
+	mImageGroups.clear();
+}
+
+
+/**
+ * Draws everything added since the last flush in sorted order, and empties the list.
+ */
+void DrawList::flush()
+{
+	sort();
+
+	auto& renderer = Utility<Renderer>::get();
+	for (const auto& entry : mEntries)
+	{
+		const auto& command = mCommands[entry.index];
+		if (command.sprite)
+		{
+			command.sprite->draw(command.position);
+		}
+		else
+		{
+			renderer.drawSubImage(*command.image, command.position, command.subImageRect, command.color);
+		}
+	}
+
+	clear();
+}
+
+
+void DrawList::push(const Command& command, const Image& image, int layer, float depth)
+{
+	if (layer < MinLayer || layer > MaxLayer)
+	{
+		throw std::runtime_error("DrawList layer out of range: " + std::to_string(layer));
+	}
+	if (mCommands.size() >= std::numeric_limits<uint32_t>::max())
+	{
+		throw std::runtime_error("DrawList is full");
+	}
+
+	// Groups are numbered in order of first use. Images past the last group share it.
+	const auto nextGroup = static_cast<uint16_t>(std::min<std::size_t>(mImageGroups.size(), std::numeric_limits<uint16_t>::max()));
+	const auto imageGroup = mImageGroups.try_emplace(&image, nextGroup).first->second;
+
+	mEntries.push_back({sortKey(layer, depth, imageGroup), static_cast<uint32_t>(mCommands.size())});
+	mCommands.push_back(command);
+}
+
+
+/**
+ * Least significant digit first radix sort of the entries by key.
+ *
+ * Counts for every digit are gathered in a single pass. Digits that are the
+ * same for all entries, such as the layer bits when one layer is used, are
+ * skipped.
+ */
+void DrawList::sort()
+{
+	std::array<std::array<std::size_t, BucketCount>, DigitCount> counts{};
+	for (const auto& entry : mEntries)
+	{
+		for (std::size_t digit = 0; digit < DigitCount; ++digit)
+		{
+			++counts[digit][(entry.key >> (digit * DigitBits)) & (BucketCount - 1)];
+		}
+	}
+
+	mSortBuffer.resize(mEntries.size());
+	for (std::size_t digit = 0; digit < DigitCount; ++digit)
+	{
+		auto& digitCounts = counts[digit];
+		if (mEntries.empty() || digitCounts[(mEntries.front().key >> (digit * DigitBits)) & (BucketCount - 1)] == mEntries.size())
+		{
+			continue;
+		}
+
+		// Convert counts to the starting offset of each bucket
+		std::size_t offset = 0;
+		for (auto& count : digitCounts)
+		{
+			const auto bucketSize = count;
+			count = offset;
+			offset += bucketSize;
+		}
+
+		for (const auto& entry : mEntries)
+		{
+			mSortBuffer[digitCounts[(entry.key >> (digit * DigitBits)) & (BucketCount - 1)]++] = entry;
+		}
+		mEntries.swap(mSortBuffer);
+	}
+}
@@ -0,0 +1,89 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include "Color.h"
+#include "../Math/Point.h"
+#include "../Math/Rectangle.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+
+namespace NAS2D
+{
+	class Image;
+	class Sprite;
+
+
+	/**
+	 * Collects draws for a frame, and draws them sorted by layer and depth.
+	 *
+	 * Lower layers are drawn first. Within a layer, lower depths are drawn
+	 * first, so an isometric view can use the y coordinate of each object's
+	 * base. Draws with equal layer and depth are grouped by image, so
+	 * consecutive quads share a texture and the renderer can batch them.
+	 *
+	 * Sorting is a stable radix sort of a 64 bit key, so the cost per frame is
+	 * linear in the number of draws.
+	 *
+	 * \code{.cpp}
+	 * drawList.add(groundImage, {0, 0}, GroundLayer, 0);
+	 * for (const auto& unit : units)
+	 * {
+	 * 	drawList.add(unit.sprite, unit.position, UnitLayer, unit.position.y);
+	 * }
+	 * drawList.flush();
+	 * \endcode
+	 */
+	class DrawList
+	{
+	public:
+		static constexpr int MinLayer{-32768};
+		static constexpr int MaxLayer{32767};
+
+		void add(const Image& image, Point<float> position, int layer, float depth, Color color = Color::Normal);
+		void add(const Image& image, Point<float> position, const Rectangle<float>& subImageRect, int layer, float depth, Color color = Color::Normal);
+		void add(const Sprite& sprite, Point<float> position, int layer, float depth);
+
+		std::size_t size() const;
+		bool empty() const;
+		void clear();
+
+		void flush();
+
+	private:
+		struct Command
+		{
+			const Image* image;
+			const Sprite* sprite;
+			Point<float> position;
+			Rectangle<float> subImageRect;
+			Color color;
+		};
+
+		struct Entry
+		{
+			uint64_t key;
+			uint32_t index;
+		};
+
+		void push(const Command& command, const Image& image, int layer, float depth);
+		void sort();
+
+		std::vector<Command> mCommands;
+		std::vector<Entry> mEntries;
+		std::vector<Entry> mSortBuffer;
+		std::unordered_map<const Image*, uint16_t> mImageGroups;
+	};
+} // namespace
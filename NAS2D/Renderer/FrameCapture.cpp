@@ -0,0 +1,312 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "FrameCapture.h"
+
+#include "../Filesystem.h"
+#include "../Utility.h"
+
+#include <SDL2/SDL.h>
+
+#if defined(__XCODE_BUILD__)
+#include <GLEW/GLEW.h>
+#include <SDL2_image/SDL_image.h>
+#else
+#include <GL/glew.h>
+#include <SDL2/SDL_image.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+
+using namespace NAS2D;
+
+
+namespace
+{
+	constexpr std::size_t DumpFrameNumberDigits{6};
+
+
+	/**
+	 * Copies pixels read by OpenGL, which start at the bottom row, into top to bottom order.
+	 */
+	std::vector<Color> copyFlipped(const void* source, Vector<int> size)
+	{
+		const auto width = static_cast<std::size_t>(size.x);
+		const auto height = static_cast<std::size_t>(size.y);
+		std::vector<Color> pixels(width * height);
+		const auto* sourceBytes = static_cast<const unsigned char*>(source);
+		for (std::size_t y = 0; y < height; ++y)
+		{
+			std::memcpy(&pixels[(height - 1 - y) * width], sourceBytes + y * width * sizeof(Color), width * sizeof(Color));
+		}
+
+		// Alpha of the window is whatever blending left behind, but the window itself is opaque
+		for (auto& pixel : pixels)
+		{
+			pixel.alpha = 255;
+		}
+		return pixels;
+	}
+
+
+	std::string encodePng(Vector<int> size, std::vector<Color>& pixels)
+	{
+		auto* surface = SDL_CreateRGBSurfaceWithFormatFrom(pixels.data(), size.x, size.y, 32, size.x * static_cast<int>(sizeof(Color)), SDL_PIXELFORMAT_RGBA32);
+		if (!surface)
+		{
+			throw std::runtime_error("Frame capture surface creation failed: " + std::string{SDL_GetError()});
+		}
+
+		// Large enough for a PNG that doesn't compress at all: a filter byte per row, plus block and chunk headers
+		const auto rawSize = pixels.size() * sizeof(Color) + static_cast<std::size_t>(size.y);
+		std::string data(rawSize + rawSize / 64 + 4096, '\0');
+		auto* stream = SDL_RWFromMem(data.data(), static_cast<int>(data.size()));
+		const auto result = IMG_SavePNG_RW(surface, stream, 0);
+		const auto length = SDL_RWtell(stream);
+		SDL_RWclose(stream);
+		SDL_FreeSurface(surface);
+
+		if (result != 0 || length < 0)
+		{
+			throw std::runtime_error("Frame capture PNG encoding failed: " + std::string{IMG_GetError()});
+		}
+		data.resize(static_cast<std::size_t>(length));
+		return data;
+	}
+}
+
+
+FrameCapture::FrameCapture() :
+	mThread{&FrameCapture::run, this}
+{
+}
+
+
+FrameCapture::~FrameCapture()
+{
+	while (!mReadbacks.empty())
+	{
+		finishReadback(mReadbacks.front());
+		mReadbacks.pop_front();
+	}
+
+	{
+		const std::lock_guard lock{mMutex};
+		mStop = true;
+	}
+	mCondition.notify_one();
+	mThread.join();
+
+	if (!mFreeBufferIds.empty())
+	{
+		glDeleteBuffers(static_cast<GLsizei>(mFreeBufferIds.size()), mFreeBufferIds.data());
+	}
+}
+
+
+/**
+ * Reads the next frame, and passes its pixels to a function on the GL thread.
+ *
+ * The function is called from update(), ReadbackDelay frames later. Pixels
+ * are RGBA, in rows from the top of the frame.
+ */
+void FrameCapture::capture(FrameCaptureCallback callback)
+{
+	mRequests.push_back(std::move(callback));
+}
+
+
+/**
+ * Saves the next frame as a PNG file.
+ */
+void FrameCapture::capture(const std::filesystem::path& filename)
+{
+	capture([this, filename](Vector<int> size, const std::vector<Color>& pixels) {
+		queueWrite({filename, size, pixels});
+	});
+}
+
+
+/**
+ * Saves every frame as a numbered PNG file, such as for recording headless runs.
+ *
+ * When encoding can't keep up, each frame waits for the worker thread, so
+ * no frames are dropped.
+ *
+ * \param	directory	Directory for the files, created if needed. Numbering restarts from 1.
+ */
+void FrameCapture::startDump(const std::filesystem::path& directory)
+{
+	Utility<Filesystem>::get().makeDirectory(directory);
+	mDumpDirectory = directory;
+	mDumpFrameNumber = 0;
+}
+
+
+void FrameCapture::stopDump()
+{
+	mDumpDirectory.reset();
+}
+
+
+bool FrameCapture::isDumping() const
+{
+	return mDumpDirectory.has_value();
+}
+
+
+/**
+ * Starts reading the finished frame, and completes earlier reads that are ready.
+ *
+ * Call once per frame, before the buffers are swapped, with the default
+ * frame buffer bound.
+ *
+ * \param	size	Size of the frame buffer in pixels.
+ */
+void FrameCapture::update(Vector<int> size)
+{
+	{
+		const std::lock_guard lock{mMutex};
+		if (!mError.empty())
+		{
+			throw std::runtime_error("Frame capture failed: " + std::exchange(mError, {}));
+		}
+	}
+
+	while (!mReadbacks.empty() && mFrame - mReadbacks.front().frame >= ReadbackDelay)
+	{
+		finishReadback(mReadbacks.front());
+		mReadbacks.pop_front();
+	}
+
+	if (mDumpDirectory)
+	{
+		auto number = std::to_string(++mDumpFrameNumber);
+		number.insert(0, DumpFrameNumberDigits - std::min(number.size(), DumpFrameNumberDigits), '0');
+		capture(*mDumpDirectory / ("frame_" + number + ".png"));
+	}
+
+	if (!mRequests.empty() && size.x > 0 && size.y > 0)
+	{
+		startReadback(size);
+	}
+	++mFrame;
+}
+
+
+void FrameCapture::startReadback(Vector<int> size)
+{
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+	if (!GLEW_VERSION_2_1 && !GLEW_ARB_pixel_buffer_object)
+	{
+		std::vector<Color> pixels(size.to<std::size_t>().x * size.to<std::size_t>().y);
+		glReadPixels(0, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		const auto flipped = copyFlipped(pixels.data(), size);
+		for (const auto& callback : std::exchange(mRequests, {}))
+		{
+			callback(size, flipped);
+		}
+		return;
+	}
+
+	GLuint bufferId;
+	if (mFreeBufferIds.empty())
+	{
+		glGenBuffers(1, &bufferId);
+	}
+	else
+	{
+		bufferId = mFreeBufferIds.back();
+		mFreeBufferIds.pop_back();
+	}
+
+	const auto byteCount = size.to<std::size_t>().x * size.to<std::size_t>().y * sizeof(Color);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, bufferId);
+	glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(byteCount), nullptr, GL_STREAM_READ);
+	// With a pack buffer bound, the copy goes to the buffer, and returns without waiting for the GPU
+	glReadPixels(0, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	mReadbacks.push_back({bufferId, size, mFrame, std::exchange(mRequests, {})});
+}
+
+
+void FrameCapture::finishReadback(const Readback& readback)
+{
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.bufferId);
+	std::vector<Color> pixels;
+	if (const auto* bufferPixels = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY))
+	{
+		pixels = copyFlipped(bufferPixels, readback.size);
+	}
+	const auto isRead = glUnmapBuffer(GL_PIXEL_PACK_BUFFER) == GL_TRUE && !pixels.empty();
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	mFreeBufferIds.push_back(readback.bufferId);
+
+	if (!isRead)
+	{
+		// Reported from the next update(), as this also runs from the destructor
+		const std::lock_guard lock{mMutex};
+		mError = "Unable to read pixel buffer";
+		return;
+	}
+
+	for (const auto& callback : readback.callbacks)
+	{
+		callback(readback.size, pixels);
+	}
+}
+
+
+void FrameCapture::queueWrite(PngWrite write)
+{
+	{
+		std::unique_lock lock{mMutex};
+		mWriteFinished.wait(lock, [this]() { return mWrites.size() < MaxQueuedWrites; });
+		mWrites.push_back(std::move(write));
+	}
+	mCondition.notify_one();
+}
+
+
+void FrameCapture::run()
+{
+	while (true)
+	{
+		std::unique_lock lock{mMutex};
+		// Pending writes are finished before stopping, so captures near exit aren't lost
+		mCondition.wait(lock, [this]() { return mStop || !mWrites.empty(); });
+		if (mWrites.empty())
+		{
+			break;
+		}
+
+		auto write = std::move(mWrites.front());
+		mWrites.pop_front();
+		lock.unlock();
+		mWriteFinished.notify_all();
+
+		try
+		{
+			Utility<Filesystem>::get().writeFile(write.filename, encodePng(write.size, write.pixels));
+		}
+		catch (const std::exception& error)
+		{
+			// Reported from update(), on the thread that asked for the capture
+			const std::lock_guard errorLock{mMutex};
+			mError = error.what();
+		}
+	}
+}
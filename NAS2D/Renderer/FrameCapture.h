@@ -0,0 +1,99 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include "Renderer.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace NAS2D
+{
+	/**
+	 * Reads back frames from the GPU without stalling, and saves them as PNG files.
+	 *
+	 * Frames are copied into pixel buffer objects, and only read from them
+	 * ReadbackDelay frames later, once the GPU has long finished the copy.
+	 * Without pixel buffer objects, frames are read immediately instead.
+	 *
+	 * PNG encoding and file writes run on a worker thread. Files are written
+	 * through Filesystem, so names are relative to its write directory.
+	 *
+	 * \note	Must be used on the thread of the GL context, and destroyed
+	 *			before the context. Destruction finishes pending captures.
+	 */
+	class FrameCapture
+	{
+	public:
+		static constexpr uint64_t ReadbackDelay{2};
+		// Captures wait for the worker thread when it falls this far behind
+		static constexpr std::size_t MaxQueuedWrites{4};
+
+		FrameCapture();
+		FrameCapture(const FrameCapture&) = delete;
+		FrameCapture& operator=(const FrameCapture&) = delete;
+		~FrameCapture();
+
+		void capture(FrameCaptureCallback callback);
+		void capture(const std::filesystem::path& filename);
+
+		void startDump(const std::filesystem::path& directory);
+		void stopDump();
+		bool isDumping() const;
+
+		void update(Vector<int> size);
+
+	private:
+		struct Readback
+		{
+			unsigned int bufferId;
+			Vector<int> size;
+			uint64_t frame;
+			std::vector<FrameCaptureCallback> callbacks;
+		};
+
+		struct PngWrite
+		{
+			std::filesystem::path filename;
+			Vector<int> size;
+			std::vector<Color> pixels;
+		};
+
+		void startReadback(Vector<int> size);
+		void finishReadback(const Readback& readback);
+		void queueWrite(PngWrite write);
+		void run();
+
+		std::vector<FrameCaptureCallback> mRequests{};
+		std::deque<Readback> mReadbacks{};
+		std::vector<unsigned int> mFreeBufferIds{};
+		uint64_t mFrame{0};
+		std::optional<std::filesystem::path> mDumpDirectory{};
+		unsigned int mDumpFrameNumber{0};
+
+		std::thread mThread{};
+		std::mutex mMutex{};
+		std::condition_variable mCondition{};
+		std::condition_variable mWriteFinished{};
+		bool mStop{false};
+		std::deque<PngWrite> mWrites{};
+		std::string mError{};
+	};
+} // namespace NAS2D
@@ -0,0 +1,274 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "PathMesh.h"
+
+#include "../Math/Vector.h"
+
+#include <cmath>
+#include <numeric>
+
+
+using namespace NAS2D;
+
+
+namespace
+{
+	float crossProduct(Vector<float> a, Vector<float> b)
+	{
+		return a.x * b.y - a.y * b.x;
+	}
+
+
+	Vector<float> unitNormal(Point<float> start, Point<float> end)
+	{
+		const auto direction = end - start;
+		const auto length = std::sqrt(direction.lengthSquared());
+		return Vector{-direction.y, direction.x} / length;
+	}
+
+
+	/**
+	 * Copies points, skipping repeats which have no direction between them.
+	 */
+	std::vector<Point<float>> distinctPoints(std::span<const Point<float>> points, bool isClosed)
+	{
+		std::vector<Point<float>> distinct;
+		distinct.reserve(points.size());
+		for (const auto& point : points)
+		{
+			if (distinct.empty() || point != distinct.back())
+			{
+				distinct.push_back(point);
+			}
+		}
+		if (isClosed && distinct.size() > 1 && distinct.front() == distinct.back())
+		{
+			distinct.pop_back();
+		}
+		return distinct;
+	}
+
+
+	/**
+	 * Whether a point is inside or on the edge of a triangle.
+	 *
+	 * \param	winding	1 for triangles with positive area, -1 for negative.
+	 */
+	bool triangleContains(Point<float> a, Point<float> b, Point<float> c, Point<float> point, float winding)
+	{
+		return crossProduct(b - a, point - a) * winding >= 0 &&
+			crossProduct(c - b, point - b) * winding >= 0 &&
+			crossProduct(a - c, point - c) * winding >= 0;
+	}
+}
+
+
+/**
+ * Tessellates a line through a series of points.
+ *
+ * Joins are mitered, or beveled where the miter would exceed MiterLimit.
+ * Open ends are cut square at the end points.
+ *
+ * \param	points		Points along the line.
+ * \param	lineWidth	Width of the line in pixels.
+ * \param	isClosed	Whether the last point joins back to the first.
+ */
+PathMesh PathMesh::polyline(std::span<const Point<float>> points, float lineWidth, bool isClosed)
+{
+	const auto path = distinctPoints(points, isClosed);
+	PathMesh mesh;
+	if (path.size() < 2 || !(lineWidth > 0))
+	{
+		return mesh;
+	}
+
+	isClosed = isClosed && path.size() > 2;
+	const auto pointCount = path.size();
+	const auto segmentCount = isClosed ? pointCount : pointCount - 1;
+	const auto halfWidth = lineWidth / 2;
+
+	std::vector<Vector<float>> normals(segmentCount);
+	for (std::size_t i = 0; i < segmentCount; ++i)
+	{
+		normals[i] = unitNormal(path[i], path[(i + 1) % pointCount]);
+	}
+
+	// Offsets of the edges of the line from each point, for the segments ending and starting there
+	std::vector<Vector<float>> endOffsets(pointCount);
+	std::vector<Vector<float>> startOffsets(pointCount);
+	mesh.mVertices.reserve(segmentCount * 6 + pointCount * 3);
+
+	for (std::size_t i = 0; i < pointCount; ++i)
+	{
+		const auto hasIncoming = isClosed || i > 0;
+		const auto hasOutgoing = isClosed || i < segmentCount;
+		if (!hasIncoming || !hasOutgoing)
+		{
+			const auto offset = normals[hasOutgoing ? i : i - 1] * halfWidth;
+			endOffsets[i] = offset;
+			startOffsets[i] = offset;
+			continue;
+		}
+
+		const auto normalIn = normals[(i + segmentCount - 1) % segmentCount];
+		const auto normalOut = normals[i];
+		const auto miter = normalIn + normalOut;
+		const auto miterLength = std::sqrt(miter.lengthSquared());
+		// Cosine of half the angle between the segments
+		const auto cosHalfAngle = miterLength / 2;
+
+		if (cosHalfAngle * MiterLimit > 1)
+		{
+			const auto offset = miter * (halfWidth / (miterLength * cosHalfAngle));
+			endOffsets[i] = offset;
+			startOffsets[i] = offset;
+			continue;
+		}
+
+		endOffsets[i] = normalIn * halfWidth;
+		startOffsets[i] = normalOut * halfWidth;
+		// Fill the gap on the outside of the turn
+		const auto outside = crossProduct(normalIn, normalOut) > 0 ? -1.0f : 1.0f;
+		const auto& point = path[i];
+		mesh.addTriangle(point, point + endOffsets[i] * outside, point + startOffsets[i] * outside);
+	}
+
+	for (std::size_t i = 0; i < segmentCount; ++i)
+	{
+		const auto next = (i + 1) % pointCount;
+		const auto startLeft = path[i] + startOffsets[i];
+		const auto startRight = path[i] - startOffsets[i];
+		const auto endLeft = path[next] + endOffsets[next];
+		const auto endRight = path[next] - endOffsets[next];
+		mesh.addTriangle(startLeft, startRight, endLeft);
+		mesh.addTriangle(endLeft, startRight, endRight);
+	}
+
+	return mesh;
+}
+
+
+/**
+ * Triangulates the inside of a simple polygon, convex or concave, by ear clipping.
+ *
+ * Points may wind either way. Self intersecting polygons still produce
+ * triangles, but they may not match any particular fill rule.
+ *
+ * \param	points	Corners of the polygon. The last point joins back to the first.
+ */
+PathMesh PathMesh::polygon(std::span<const Point<float>> points)
+{
+	const auto path = distinctPoints(points, true);
+	PathMesh mesh;
+	if (path.size() < 3)
+	{
+		return mesh;
+	}
+
+	auto doubleArea = 0.0f;
+	for (std::size_t i = 0; i < path.size(); ++i)
+	{
+		const auto& next = path[(i + 1) % path.size()];
+		doubleArea += path[i].x * next.y - next.x * path[i].y;
+	}
+	const auto winding = doubleArea < 0 ? -1.0f : 1.0f;
+
+	std::vector<std::size_t> remaining(path.size());
+	std::iota(remaining.begin(), remaining.end(), std::size_t{0});
+	mesh.mVertices.reserve((path.size() - 2) * 3);
+
+	const auto isEar = [&](std::size_t previous, std::size_t current, std::size_t next) {
+		const auto& a = path[remaining[previous]];
+		const auto& b = path[remaining[current]];
+		const auto& c = path[remaining[next]];
+		for (const auto index : remaining)
+		{
+			const auto& point = path[index];
+			if (point != a && point != b && point != c && triangleContains(a, b, c, point, winding))
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	std::size_t current = 0;
+	std::size_t failedCount = 0;
+	while (remaining.size() > 3)
+	{
+		const auto count = remaining.size();
+		const auto previous = (current + count - 1) % count;
+		const auto next = (current + 1) % count;
+		const auto& a = path[remaining[previous]];
+		const auto& b = path[remaining[current]];
+		const auto& c = path[remaining[next]];
+		const auto turn = crossProduct(b - a, c - b) * winding;
+
+		// Collinear corners enclose nothing, and are dropped without a triangle
+		// If no ear is left, the polygon intersects itself, so clip anyway to finish
+		const auto isClipped = turn == 0 || (turn > 0 && isEar(previous, current, next)) || failedCount >= count;
+		if (!isClipped)
+		{
+			current = next;
+			++failedCount;
+			continue;
+		}
+
+		if (turn != 0)
+		{
+			mesh.addTriangle(a, b, c);
+		}
+		remaining.erase(remaining.begin() + static_cast<std::ptrdiff_t>(current));
+		current %= remaining.size();
+		failedCount = 0;
+	}
+
+	mesh.addTriangle(path[remaining[0]], path[remaining[1]], path[remaining[2]]);
+	return mesh;
+}
+
+
+/**
+ * Vertices of the triangles, three per triangle.
+ */
+const std::vector<Point<float>>& PathMesh::vertices() const
+{
+	return mVertices;
+}
+
+
+std::size_t PathMesh::triangleCount() const
+{
+	return mVertices.size() / 3;
+}
+
+
+bool PathMesh::empty() const
+{
+	return mVertices.empty();
+}
+
+
+/**
+ * Adds the triangles of another mesh, such as a fill and its outline, so they draw in one call.
+ */
+void PathMesh::append(const PathMesh& other)
+{
+	mVertices.insert(mVertices.end(), other.mVertices.begin(), other.mVertices.end());
+}
+
+
+void PathMesh::addTriangle(Point<float> a, Point<float> b, Point<float> c)
+{
+	mVertices.push_back(a);
+	mVertices.push_back(b);
+	mVertices.push_back(c);
+}
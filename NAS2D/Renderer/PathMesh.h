@@ -0,0 +1,57 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include "../Math/Point.h"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+
+namespace NAS2D
+{
+	/**
+	 * Triangles of a tessellated path, kept so the path can be drawn many times
+	 * without tessellating it again.
+	 *
+	 * Suited to shapes that rarely change, such as graphs, map borders, and
+	 * outlines. Build the mesh when the points change, and draw it each frame.
+	 *
+	 * \code{.cpp}
+	 * const auto graphLine = PathMesh::polyline(samples, 2.0f);
+	 * renderer.drawPathMesh(graphLine, graphPosition, Color::Green);
+	 * \endcode
+	 */
+	class PathMesh
+	{
+	public:
+		// Sharper joins are beveled, rather than mitered out past this multiple of the half width
+		static constexpr float MiterLimit{4.0f};
+
+		static PathMesh polyline(std::span<const Point<float>> points, float lineWidth, bool isClosed = false);
+		static PathMesh polygon(std::span<const Point<float>> points);
+
+		PathMesh() = default;
+
+		const std::vector<Point<float>>& vertices() const;
+		std::size_t triangleCount() const;
+		bool empty() const;
+
+		void append(const PathMesh& other);
+
+	private:
+		void addTriangle(Point<float> a, Point<float> b, Point<float> c);
+
+		// Three vertices per triangle
+		std::vector<Point<float>> mVertices;
+	};
+} // namespace
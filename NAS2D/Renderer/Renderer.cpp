@@ -9,6 +9,7 @@
 // ==================================================================================
 
 #include "Renderer.h"
+#include "PathMesh.h"
 #include "../Math/Rectangle.h"
 
 #include <algorithm>
@@ -30,6 +31,28 @@ void Renderer::drawTextShadow(const Font& font, std::string_view text, Point<flo
 }
 
 
+/**
+ * Draws a line through a series of points, with mitered joins.
+ *
+ * Tessellates the line on each call. Keep a PathMesh for lines that rarely change.
+ */
+void Renderer::drawPolyline(std::span<const Point<float>> points, Color color, float lineWidth, bool isClosed)
+{
+	drawPathMesh(PathMesh::polyline(points, lineWidth, isClosed), {0, 0}, color);
+}
+
+
+/**
+ * Fills a simple polygon, which may be concave.
+ *
+ * Triangulates the polygon on each call. Keep a PathMesh for shapes that rarely change.
+ */
+void Renderer::drawPolygonFilled(std::span<const Point<float>> points, Color color)
+{
+	drawPathMesh(PathMesh::polygon(points), {0, 0}, color);
+}
+
+
 Point<int> Renderer::center() const
 {
 	return Point{0, 0} + mResolution / 2;
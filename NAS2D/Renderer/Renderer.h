@@ -17,6 +17,9 @@
 #include "../Signal/Signal.h"
 
 #include <chrono>
+#include <filesystem>
+#include <functional>
+#include <span>
 #include <string_view>
 #include <string>
 #include <vector>
@@ -27,11 +30,16 @@ namespace NAS2D
 
 	class Font;
 	class Image;
+	class PathMesh;
 
 	template <typename BaseType>
 	struct Rectangle;
 
 
+	// Receives a captured frame as RGBA pixels, in rows from the top
+	using FrameCaptureCallback = std::function<void(Vector<int> size, const std::vector<Color>& pixels)>;
+
+
 	class Renderer : public Window
 	{
 	public:
@@ -56,10 +64,14 @@ namespace NAS2D
 		virtual void drawBox(const Rectangle<float>& rect, Color color = Color::White) = 0;
 		virtual void drawBoxFilled(const Rectangle<float>& rect, Color color = Color::White) = 0;
 		virtual void drawCircle(Point<float> position, float radius, Color color, int num_segments = 10, Vector<float> scale = Vector{1.0f, 1.0f}) = 0;
+		void drawPolyline(std::span<const Point<float>> points, Color color = Color::White, float lineWidth = 1.0f, bool isClosed = false);
+		void drawPolygonFilled(std::span<const Point<float>> points, Color color = Color::White);
+		virtual void drawPathMesh(const PathMesh& mesh, Point<float> position = {0, 0}, Color color = Color::White) = 0;
 
 		virtual void drawGradient(const Rectangle<float>& rect, Color colorUpperLeft, Color colorLowerLeft, Color colorLowerRight, Color colorUpperRight) = 0;
 
-		virtual void drawText(const Font& font, std::string_view text, Point<float> position, Color color = Color::White) = 0;
+		virtual void drawText(const Font& font, std::string_view text, Point<float> position, Color color = Color::White, float scale = 1.0f) = 0;
+		virtual void drawTextToImage(const Font& font, std::string_view text, const Image& destination, Point<float> dstPoint, Color color = Color::White) = 0;
 		void drawTextShadow(const Font& font, std::string_view text, Point<float> position, Vector<float> shadowOffset, Color textColor, Color shadowColor);
 
 		virtual void clearScreen(Color color = Color::Black) = 0;
@@ -71,6 +83,11 @@ namespace NAS2D
 
 		virtual void update() = 0;
 
+		virtual void captureFrameAsync(FrameCaptureCallback callback) = 0;
+		virtual void captureFrameAsync(const std::filesystem::path& filename) = 0;
+		virtual void startFrameDump(const std::filesystem::path& directory) = 0;
+		virtual void stopFrameDump() = 0;
+
 		virtual void setViewport(const Rectangle<int>& viewport) = 0;
 		virtual void setOrthoProjection(const Rectangle<float>& orthoBounds) = 0;
 
@@ -40,10 +40,12 @@ namespace NAS2D
 		void drawBox(const Rectangle<float>&, Color = Color::White) override {}
 		void drawBoxFilled(const Rectangle<float>&, Color = Color::White) override {}
 		void drawCircle(Point<float>, float, Color, int = 10, Vector<float> = Vector{1.0f, 1.0f}) override {}
+		void drawPathMesh(const PathMesh&, Point<float> = {0, 0}, Color = Color::White) override {}
 
 		void drawGradient(const Rectangle<float>&, Color, Color, Color, Color) override {}
 
-		void drawText(const Font&, std::string_view, Point<float>, Color = Color::White) override {}
+		void drawText(const Font&, std::string_view, Point<float>, Color = Color::White, float = 1.0f) override {}
+		void drawTextToImage(const Font&, std::string_view, const Image&, Point<float>, Color = Color::White) override {}
 
 		void clearScreen(Color = Color::Black) override {}
 
@@ -52,6 +54,11 @@ namespace NAS2D
 
 		void update() override {}
 
+		void captureFrameAsync(FrameCaptureCallback) override {}
+		void captureFrameAsync(const std::filesystem::path&) override {}
+		void startFrameDump(const std::filesystem::path&) override {}
+		void stopFrameDump() override {}
+
 		void setViewport(const Rectangle<int>&) override {}
 		void setOrthoProjection(const Rectangle<float>&) override {}
 	};
@@ -9,16 +9,22 @@
 // ==================================================================================
 
 #include "RendererOpenGL.h"
+#include "FrameCapture.h"
+#include "PathMesh.h"
+#include "ResolutionScale.h"
+#include "TextureChange.h"
 
 #include "../Math/VectorSizeRange.h"
 #include "../Resource/Image.h"
 #include "../Resource/Font.h"
+#include "../Resource/TiledTexture.h"
 #include "../Math/Trig.h"
 #include "../Configuration.h"
 #include "../EventHandler.h"
 #include "../Filesystem.h"
 #include "../Math/MathUtils.h"
 #include "../Utility.h"
+#include "../Utf8.h"
 
 #include <SDL2/SDL.h>
 
@@ -79,8 +85,47 @@ namespace
 	constexpr auto DefaultTextureCoords = rectToQuad({{0, 0}, {1, 1}});
 
 
+	// Distance field glyphs have their edge at the midpoint value, which is
+	// smoothed over about one screen pixel, whatever the scale
+	constexpr auto DistanceFieldVertexShader = R"(
+		#version 120
+		void main()
+		{
+			gl_TexCoord[0] = gl_MultiTexCoord0;
+			gl_FrontColor = gl_Color;
+			gl_Position = ftransform();
+		}
+	)";
+
+	constexpr auto DistanceFieldFragmentShader = R"(
+		#version 120
+		uniform sampler2D glyphTexture;
+		void main()
+		{
+			float distance = texture2D(glyphTexture, gl_TexCoord[0].xy).a;
+			float smoothing = 0.7 * fwidth(distance);
+			float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
+			gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * alpha);
+		}
+	)";
+
+
 	void drawTexturedQuad(GLuint textureId, const std::array<GLfloat, 12>& verticies, const std::array<GLfloat, 12>& textureCoords = DefaultTextureCoords);
 	void line(Point<float> p1, Point<float> p2, float lineWidth, Color color);
+	GLuint linkShaderProgram(const char* vertexSource, const char* fragmentSource);
+
+	Rectangle<float> intersection(const Rectangle<float>& a, const Rectangle<float>& b)
+	{
+		return Rectangle<float>::Create(
+			{std::max(a.position.x, b.position.x), std::max(a.position.y, b.position.y)},
+			{std::min(a.endPoint().x, b.endPoint().x), std::min(a.endPoint().y, b.endPoint().y)});
+	}
+
+	// Opaque pixels drawn with an opaque tint replace what is underneath, so blending them is wasted fill rate
+	bool needsBlending(const Image& image, Color color)
+	{
+		return color.alpha != 255 || !image.isOpaque();
+	}
 
 	void setColor(Color color)
 	{
@@ -103,6 +148,7 @@ RendererOpenGL::Options RendererOpenGL::ReadConfigurationOptions()
 		{graphics.get<int>("screenwidth"), graphics.get<int>("screenheight")},
 		graphics.get<bool>("fullscreen"),
 		graphics.get<bool>("vsync"),
+		graphics.get("adaptivevsync", false),
 	};
 }
 
@@ -115,6 +161,7 @@ void RendererOpenGL::WriteConfigurationOptions(const Options& options)
 	graphics.set("screenheight", options.resolution.y);
 	graphics.set("fullscreen", options.fullscreen);
 	graphics.set("vsync", options.vsync);
+	graphics.set("adaptivevsync", options.adaptiveVsync);
 }
 
 
@@ -127,14 +174,22 @@ RendererOpenGL::RendererOpenGL(const std::string& title) :
 RendererOpenGL::RendererOpenGL(const std::string& title, const Options& options) :
 	Renderer(title)
 {
-	initVideo(options.resolution, options.fullscreen, options.vsync);
+	initVideo(options.resolution, options.fullscreen, options.vsync, options.adaptiveVsync);
 }
 
 
 RendererOpenGL::~RendererOpenGL()
 {
+	setTextureChangeHandler({});
 	Utility<EventHandler>::get().windowResized().disconnect({this, &RendererOpenGL::onResize});
 
+	mFrameCapture.reset();
+	deleteSceneTarget();
+	if (mDistanceFieldShader != 0)
+	{
+		glDeleteProgram(mDistanceFieldShader);
+	}
+
 	SDL_GL_DeleteContext(sdlOglContext);
 	SDL_DestroyWindow(underlyingWindow);
 	underlyingWindow = nullptr;
@@ -166,31 +221,127 @@ std::string RendererOpenGL::getShaderVersion()
 }
 
 
-void RendererOpenGL::drawImage(const Image& image, Point<float> position, float scale, Color color)
+/**
+ * Draws the scene to an offscreen target whose resolution adapts to keep frame time near a target.
+ *
+ * The scale is adjusted once per frame in update(), where the target is
+ * upscaled to the window. Drawing after beginOverlay() goes straight to the
+ * window, at native resolution.
+ *
+ * \param	settings	Range of the scale, as a fraction of the window size, and the frame time to aim for in milliseconds.
+ */
+void RendererOpenGL::enableDynamicResolution(const DynamicResolution& settings)
 {
-	setColor(color);
+	if (!(settings.minimumScale > 0.0f && settings.minimumScale <= settings.maximumScale))
+	{
+		throw std::runtime_error("Dynamic resolution scale range is invalid: " + std::to_string(settings.minimumScale) + " to " + std::to_string(settings.maximumScale));
+	}
+	if (!(GLEW_VERSION_3_0 || GLEW_ARB_framebuffer_object))
+	{
+		throw std::runtime_error("Dynamic resolution requires frame buffer object support");
+	}
+
+	flushBatch();
+	deleteSceneTarget();
 
+	mDynamicResolution = settings;
+	mResolutionScale = settings.maximumScale;
+	mAverageFrameTime = static_cast<float>(settings.targetFrameTime);
+	mFrameTimer.reset();
+
+	createSceneTarget();
+	bindSceneTarget();
+}
+
+
+void RendererOpenGL::disableDynamicResolution()
+{
+	flushBatch();
+
+	mDynamicResolution.reset();
+	mIsDrawingScene = false;
+	mResolutionScale = 1.0f;
+	deleteSceneTarget();
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	applyViewport();
+}
+
+
+bool RendererOpenGL::isDynamicResolutionEnabled() const
+{
+	return mDynamicResolution.has_value();
+}
+
+
+/**
+ * Resolution the scene is drawn at, as a fraction of the window size.
+ */
+float RendererOpenGL::resolutionScale() const
+{
+	return mResolutionScale;
+}
+
+
+/**
+ * Upscales the scene drawn so far to the window, so the rest of the frame is drawn at native resolution.
+ *
+ * Use for text and other HUD elements that should stay sharp. Does nothing
+ * without dynamic resolution, or if called again in the same frame.
+ */
+void RendererOpenGL::beginOverlay()
+{
+	if (!mIsDrawingScene)
+	{
+		return;
+	}
+
+	flushBatch();
+	presentSceneTarget();
+}
+
+
+void RendererOpenGL::drawImage(const Image& image, Point<float> position, float scale, Color color)
+{
 	const auto imageSize = image.size().to<float>() * scale;
+	if (image.isTiled())
+	{
+		flushBatch();
+		setBlending(needsBlending(image, color));
+		setColor(color);
+		drawImageTiles(image, {position, imageSize}, {{0, 0}, image.size().to<float>()}, mOrthoBounds);
+		return;
+	}
+
 	const auto vertexArray = rectToQuad({position, imageSize});
-	drawTexturedQuad(image.textureId(), vertexArray);
+	batchImageQuad(image, vertexArray, DefaultTextureCoords, color, isMinified(imageSize, image.size().to<float>()));
 }
 
 
 void RendererOpenGL::drawSubImage(const Image& image, Point<float> raster, const Rectangle<float>& subImageRect, Color color)
 {
-	setColor(color);
-
 	const auto& subImageSize = subImageRect.size;
-	const auto vertexArray = rectToQuad({raster, subImageSize});
+	if (image.isTiled())
+	{
+		flushBatch();
+		setBlending(needsBlending(image, color));
+		setColor(color);
+		drawImageTiles(image, {raster, subImageSize}, subImageRect, mOrthoBounds);
+		return;
+	}
+
+	const auto destination = Rectangle{raster, subImageSize};
+	const auto vertexArray = rectToQuad(destination);
 	const auto imageSize = image.size().to<float>();
 	const auto textureCoordArray = rectToQuad(subImageRect.skewInverseBy(imageSize));
-
-	drawTexturedQuad(image.textureId(), vertexArray, textureCoordArray);
+	batchImageQuad(image, vertexArray, textureCoordArray, color, isMinified(destination.size, subImageRect.size));
 }
 
 
 void RendererOpenGL::drawSubImageRotated(const Image& image, Point<float> raster, const Rectangle<float>& subImageRect, float degrees, Color color)
 {
+	flushBatch();
+	setBlending(needsBlending(image, color));
+
 	glPushMatrix();
 
 	const auto translate = subImageRect.size.to<float>() / 2;
@@ -201,10 +352,20 @@ void RendererOpenGL::drawSubImageRotated(const Image& image, Point<float> raster
 
 	setColor(color);
 
-	const auto vertexArray = rectToQuad({{-translate.x, -translate.y}, translate * 2});
+	const auto destination = Rectangle{{-translate.x, -translate.y}, translate * 2};
+	if (image.isTiled())
+	{
+		// Rotated bounds aren't culled to the view
+		drawImageTiles(image, destination, subImageRect, destination);
+		glPopMatrix();
+		return;
+	}
+
+	const auto vertexArray = rectToQuad(destination);
 	const auto imageSize = image.size().to<float>();
 	const auto textureCoordArray = rectToQuad(subImageRect.skewInverseBy(imageSize));
 
+	image.setMinificationFilter(isMinified(destination.size, subImageRect.size));
 	drawTexturedQuad(image.textureId(), vertexArray, textureCoordArray);
 
 	glPopMatrix();
@@ -213,6 +374,9 @@ void RendererOpenGL::drawSubImageRotated(const Image& image, Point<float> raster
 
 void RendererOpenGL::drawImageRotated(const Image& image, Point<float> position, float degrees, Color color, float scale)
 {
+	flushBatch();
+	setBlending(needsBlending(image, color));
+
 	glPushMatrix();
 
 	const auto halfSize = image.size().to<float>() / 2;
@@ -226,8 +390,17 @@ void RendererOpenGL::drawImageRotated(const Image& image, Point<float> position,
 	setColor(color);
 	glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
 
-	const auto vertexArray = rectToQuad({{-scaledHalfSize.x, -scaledHalfSize.y}, scaledHalfSize * 2});
+	const auto destination = Rectangle{{-scaledHalfSize.x, -scaledHalfSize.y}, scaledHalfSize * 2};
+	if (image.isTiled())
+	{
+		// Rotated bounds aren't culled to the view
+		drawImageTiles(image, destination, {{0, 0}, halfSize * 2}, destination);
+		glPopMatrix();
+		return;
+	}
 
+	const auto vertexArray = rectToQuad(destination);
+	image.setMinificationFilter(isMinified(scaledHalfSize * 2, halfSize * 2));
 	drawTexturedQuad(image.textureId(), vertexArray);
 	glPopMatrix();
 }
@@ -235,18 +408,44 @@ void RendererOpenGL::drawImageRotated(const Image& image, Point<float> position,
 
 void RendererOpenGL::drawImageStretched(const Image& image, const Rectangle<float>& rect, Color color)
 {
+	flushBatch();
+	setBlending(needsBlending(image, color));
+
 	setColor(color);
 	glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
 
+	if (image.isTiled())
+	{
+		drawImageTiles(image, rect, {{0, 0}, image.size().to<float>()}, mOrthoBounds);
+		return;
+	}
+
 	const auto vertexArray = rectToQuad(rect);
+	image.setMinificationFilter(isMinified(rect.size, image.size().to<float>()));
 	drawTexturedQuad(image.textureId(), vertexArray);
 }
 
 
 void RendererOpenGL::drawImageRepeated(const Image& image, const Rectangle<float>& rect)
 {
+	flushBatch();
+	setBlending(needsBlending(image, Color::White));
+
 	setColor(Color::White);
 
+	// Tiles can't wrap as one texture, so each repeat is drawn, clipped to the area
+	if (image.isTiled())
+	{
+		const auto imageSize = image.size().to<float>();
+		const auto visible = intersection(rect, mOrthoBounds);
+		const auto repeatCount = rect.size.skewInverseBy(imageSize).to<int>() + Vector{1, 1};
+		for (const auto repeatOffset : VectorSizeRange(repeatCount))
+		{
+			drawImageTiles(image, {rect.position + repeatOffset.to<float>().skewBy(imageSize), imageSize}, {{0, 0}, imageSize}, visible);
+		}
+		return;
+	}
+
 	glBindTexture(GL_TEXTURE_2D, image.textureId());
 
 	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -294,6 +493,9 @@ void RendererOpenGL::drawSubImageRepeated(const Image& image, const Rectangle<fl
 
 void RendererOpenGL::drawImageToImage(const Image& source, const Image& destination, Point<float> dstPoint)
 {
+	flushBatch();
+	setBlending(needsBlending(source, Color::White));
+
 	const auto dstPointInt = dstPoint.to<int>();
 	const auto sourceSize = source.size();
 
@@ -305,27 +507,48 @@ void RendererOpenGL::drawImageToImage(const Image& source, const Image& destinat
 		return;
 	}
 
-	const auto availableSize = destinationBounds.endPoint() - dstPointInt;
-	const auto clipSize = Vector{std::min(sourceSize.x, availableSize.x), std::min(sourceSize.y, availableSize.y)}.to<float>();
-
 	setColor(Color::White);
 
-	glBindTexture(GL_TEXTURE_2D, destination.textureId());
+	const auto destinationSize = destination.size();
 
-	GLuint fbo = destination.frameBufferObjectId();
-	glBindFramebuffer(GL_FRAMEBUFFER, fbo);
-	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, destination.textureId(), 0);
-	// OpenGL expects UV texture coordinates to start at the lower left.
-	const auto vertexArray = rectToQuad({{dstPoint.x, static_cast<float>(destination.size().y) - dstPoint.y}, {clipSize.x, -clipSize.y}});
+	// Texture must exist before the frame buffer object can attach to it
+	destination.textureId();
+	glBindFramebuffer(GL_FRAMEBUFFER, destination.frameBufferObjectId());
 
-	drawTexturedQuad(source.textureId(), vertexArray);
-	glBindTexture(GL_TEXTURE_2D, destination.textureId());
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	// The viewport may be scaled for dynamic resolution, and the clip rect is for the window
+	glPushAttrib(GL_VIEWPORT_BIT | GL_SCISSOR_BIT);
+	glDisable(GL_SCISSOR_TEST);
+	glViewport(0, 0, destinationSize.x, destinationSize.y);
+
+	// Frame buffer rows start at the bottom, which matches the top down row order of texture data
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+	glOrtho(0.0, destinationSize.x, 0.0, destinationSize.y, -1.0, 1.0);
+	glMatrixMode(GL_MODELVIEW);
+
+	// Parts outside the destination are clipped by the viewport
+	drawTexturedQuad(source.textureId(), rectToQuad({dstPoint, sourceSize.to<float>()}));
+
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+	glPopAttrib();
+
+	glBindFramebuffer(GL_FRAMEBUFFER, drawFrameBufferId());
+	destination.updateMipmaps();
+	if (!source.isOpaque())
+	{
+		destination.markTranslucent();
+	}
 }
 
 
 void RendererOpenGL::drawPoint(Point<float> position, Color color)
 {
+	flushBatch();
+	setBlending(true);
+
 	glDisable(GL_TEXTURE_2D);
 
 	setColor(color);
@@ -341,6 +564,9 @@ void RendererOpenGL::drawPoint(Point<float> position, Color color)
 
 void RendererOpenGL::drawLine(Point<float> startPosition, Point<float> endPosition, Color color, int line_width)
 {
+	flushBatch();
+	setBlending(true);
+
 	glDisable(GL_TEXTURE_2D);
 	glEnableClientState(GL_COLOR_ARRAY);
 
@@ -353,6 +579,8 @@ void RendererOpenGL::drawLine(Point<float> startPosition, Point<float> endPositi
 
 void RendererOpenGL::drawCircle(Point<float> position, float radius, Color color, int num_segments, Vector<float> scale)
 {
+	flushBatch();
+	setBlending(true);
 
 	/*
 	* See: http://slabode.exofire.net/circle_draw.shtml.
@@ -389,8 +617,46 @@ void RendererOpenGL::drawCircle(Point<float> position, float radius, Color color
 }
 
 
+/**
+ * Draws the triangles of a tessellated path.
+ *
+ * \param	position	Offset added to the points of the mesh.
+ */
+void RendererOpenGL::drawPathMesh(const PathMesh& mesh, Point<float> position, Color color)
+{
+	if (mesh.empty())
+	{
+		return;
+	}
+
+	flushBatch();
+	setBlending(true);
+
+	glDisable(GL_TEXTURE_2D);
+	setColor(color);
+
+	glPushMatrix();
+	glTranslatef(position.x, position.y, 0.0f);
+
+	// Meshes have more vertices than any texture coordinate array set up for quads
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+
+	const auto& vertices = mesh.vertices();
+	glVertexPointer(2, GL_FLOAT, sizeof(vertices[0]), vertices.data());
+	glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size()));
+
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+
+	glPopMatrix();
+	glEnable(GL_TEXTURE_2D);
+}
+
+
 void RendererOpenGL::drawGradient(const Rectangle<float>& rect, Color c1, Color c2, Color c3, Color c4)
 {
+	flushBatch();
+	setBlending(true);
+
 	glEnableClientState(GL_COLOR_ARRAY);
 	glDisable(GL_TEXTURE_2D);
 
@@ -439,6 +705,9 @@ void RendererOpenGL::drawGradient(const Rectangle<float>& rect, Color c1, Color
 
 void RendererOpenGL::drawBox(const Rectangle<float>& rect, Color color)
 {
+	flushBatch();
+	setBlending(true);
+
 	if (rect.empty())
 	{
 		return;
@@ -461,6 +730,9 @@ void RendererOpenGL::drawBox(const Rectangle<float>& rect, Color color)
 
 void RendererOpenGL::drawBoxFilled(const Rectangle<float>& rect, Color color)
 {
+	flushBatch();
+	setBlending(true);
+
 	if (rect.empty())
 	{
 		return;
@@ -476,37 +748,93 @@ void RendererOpenGL::drawBoxFilled(const Rectangle<float>& rect, Color color)
 }
 
 
-void RendererOpenGL::drawText(const Font& font, std::string_view text, Point<float> position, Color color)
+/**
+ * Draws UTF-8 encoded text.
+ *
+ * \param	scale	Size multiplier. Distance field fonts stay sharp when scaled,
+ *					other fonts are stretched.
+ */
+void RendererOpenGL::drawText(const Font& font, std::string_view text, Point<float> position, Color color, float scale)
 {
 	if (text.empty()) { return; }
 
-	setColor(color);
-
-	const auto& gml = font.metrics();
-	if (gml.empty()) { return; }
+	const auto isDistanceField = font.glyphType() == Font::GlyphType::DistanceField;
 
-	int offset = 0;
-	for (auto character : text)
+	float offset = 0;
+	for (const auto codepoint : Utf8CodepointRange{text})
 	{
-		const auto& gm = gml[std::clamp<std::size_t>(static_cast<uint8_t>(character), 0, 255)];
+		const auto& gm = font.glyphMetrics(codepoint);
 
-		const auto glyphCellSize = font.glyphCellSize().to<float>();
-		const auto adjustX = (gm.minX < 0) ? gm.minX : 0;
-		const auto vertexArray = rectToQuad({{position.x + offset + adjustX, position.y}, glyphCellSize});
-		const auto textureCoordArray = rectToQuad(gm.uvRect);
+		if (!gm.drawBounds.empty())
+		{
+			const auto glyphRect = gm.drawBounds.to<float>().skewBy({scale, scale});
+			const auto vertexArray = rectToQuad(glyphRect.translate({position.x + offset, position.y}));
+			const auto textureCoordArray = rectToQuad(gm.uvRect);
 
-		drawTexturedQuad(font.textureId(), vertexArray, textureCoordArray);
-		offset += gm.advance;
+			batchTexturedQuad(gm.textureId, vertexArray, textureCoordArray, color, isDistanceField);
+		}
+		offset += static_cast<float>(gm.advance) * scale;
 	}
 }
 
 
+/**
+ * Renders text into an Image, for later drawing as a single quad.
+ *
+ * The destination alpha accumulates glyph coverage, and color channels are
+ * set to the text color, so the result can be drawn with normal blending.
+ */
+void RendererOpenGL::drawTextToImage(const Font& font, std::string_view text, const Image& destination, Point<float> dstPoint, Color color)
+{
+	if (text.empty()) { return; }
+
+	flushBatch();
+	// Set before the attributes are pushed, so restoring them matches the tracked state
+	setBlending(true);
+
+	const auto destinationSize = destination.size();
+
+	// Texture must exist before the frame buffer object can attach to it
+	destination.textureId();
+	glBindFramebuffer(GL_FRAMEBUFFER, destination.frameBufferObjectId());
+
+	glPushAttrib(GL_VIEWPORT_BIT | GL_COLOR_BUFFER_BIT | GL_SCISSOR_BIT);
+	glDisable(GL_SCISSOR_TEST);
+	glBlendFuncSeparate(GL_ONE, GL_ZERO, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+	glViewport(0, 0, destinationSize.x, destinationSize.y);
+
+	// Frame buffer rows start at the bottom, which matches the top down row order of texture data
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+	glOrtho(0.0, destinationSize.x, 0.0, destinationSize.y, -1.0, 1.0);
+	glMatrixMode(GL_MODELVIEW);
+
+	drawText(font, text, dstPoint, color);
+	flushBatch();
+
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+	glPopAttrib();
+
+	glBindFramebuffer(GL_FRAMEBUFFER, drawFrameBufferId());
+	destination.updateMipmaps();
+	destination.markTranslucent();
+}
+
+
 void RendererOpenGL::clipRect(const Rectangle<float>& rect)
 {
+	flushBatch();
+
 	const auto intRect = rect.to<int>();
 	const auto& position = intRect.position;
 	const auto& clipSize = intRect.size;
-	glScissor(position.x, size().y - (position.y + clipSize.y), clipSize.x, clipSize.y);
+	// Scissor box is in pixels of the draw target
+	const auto scale = drawScale();
+	const auto scaled = [scale](int value) { return static_cast<int>(std::lround(static_cast<float>(value) * scale)); };
+	glScissor(scaled(position.x), scaled(size().y - (position.y + clipSize.y)), scaled(clipSize.x), scaled(clipSize.y));
 
 	glEnable(GL_SCISSOR_TEST);
 }
@@ -514,12 +842,16 @@ void RendererOpenGL::clipRect(const Rectangle<float>& rect)
 
 void RendererOpenGL::clipRectClear()
 {
+	flushBatch();
+
 	glDisable(GL_SCISSOR_TEST);
 }
 
 
 void RendererOpenGL::clearScreen(Color color)
 {
+	flushBatch();
+
 	glClearColor(static_cast<float>(color.red) / 255.0f, static_cast<float>(color.green) / 255.0f, static_cast<float>(color.blue) / 255.0f, static_cast<float>(color.alpha) / 255.0f);
 	glClear(GL_COLOR_BUFFER_BIT);
 }
@@ -527,7 +859,66 @@ void RendererOpenGL::clearScreen(Color color)
 
 void RendererOpenGL::update()
 {
+	flushBatch();
+
+	if (mIsDrawingScene)
+	{
+		presentSceneTarget();
+	}
+
+	if (mFrameCapture)
+	{
+		mFrameCapture->update(size());
+	}
+
 	SDL_GL_SwapWindow(underlyingWindow);
+
+	if (mDynamicResolution)
+	{
+		updateResolutionScale();
+		bindSceneTarget();
+	}
+}
+
+
+/**
+ * Reads the next finished frame, and passes its pixels to a function.
+ *
+ * The read completes a couple of frames later, so it doesn't wait for the
+ * GPU. The function is called from a later update().
+ */
+void RendererOpenGL::captureFrameAsync(FrameCaptureCallback callback)
+{
+	frameCapture().capture(std::move(callback));
+}
+
+
+/**
+ * Saves the next finished frame as a PNG file, relative to the Filesystem write directory.
+ *
+ * Encoding and writing run on a worker thread.
+ */
+void RendererOpenGL::captureFrameAsync(const std::filesystem::path& filename)
+{
+	frameCapture().capture(filename);
+}
+
+
+/**
+ * Saves every frame as a numbered PNG file in a directory, until stopFrameDump().
+ */
+void RendererOpenGL::startFrameDump(const std::filesystem::path& directory)
+{
+	frameCapture().startDump(directory);
+}
+
+
+void RendererOpenGL::stopFrameDump()
+{
+	if (mFrameCapture)
+	{
+		mFrameCapture->stopDump();
+	}
 }
 
 
@@ -537,23 +928,256 @@ void RendererOpenGL::onResize(Vector<int> newSize)
 	setViewport(viewportRect);
 	setOrthoProjection(viewportRect.to<float>());
 	setResolution(newSize);
+
+	if (mDynamicResolution)
+	{
+		// Called from the window resize signal, so a failure can't be passed on to the caller
+		try
+		{
+			deleteSceneTarget();
+			createSceneTarget();
+			if (mIsDrawingScene)
+			{
+				bindSceneTarget();
+			}
+		}
+		catch (const std::runtime_error& error)
+		{
+			SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "Dynamic resolution disabled: %s", error.what());
+		}
+	}
 }
 
 void RendererOpenGL::setViewport(const Rectangle<int>& viewport)
 {
-	const auto& position = viewport.position;
-	const auto& size = viewport.size;
-	glViewport(position.x, position.y, size.x, size.y);
+	flushBatch();
+
+	mViewport = viewport;
+	applyViewport();
 }
 
 
 void RendererOpenGL::setOrthoProjection(const Rectangle<float>& orthoBounds)
 {
+	flushBatch();
+
 	glMatrixMode(GL_PROJECTION);
 	glLoadIdentity();
 	const auto bounds = orthoBounds.to<double>();
 	glOrtho(bounds.position.x, bounds.endPoint().x, bounds.endPoint().y, bounds.position.y, -1.0, 1.0);
 	glMatrixMode(GL_MODELVIEW);
+	mOrthoBounds = orthoBounds;
+}
+
+
+/**
+ * Whether drawing covers fewer screen pixels than it samples from the texture.
+ *
+ * Uses the viewport and projection scale, but not the model view matrix.
+ */
+bool RendererOpenGL::isMinified(Vector<float> drawnSize, Vector<float> sourceSize) const
+{
+	const auto pixelsPerUnit = mOrthoBounds.null() ?
+		Vector{1.0f, 1.0f} :
+		mViewportSize.to<float>().skewInverseBy(mOrthoBounds.size);
+	const auto drawnPixels = drawnSize.skewBy(pixelsPerUnit);
+	return std::abs(drawnPixels.x) < sourceSize.x || std::abs(drawnPixels.y) < sourceSize.y;
+}
+
+
+/**
+ * Scale from window pixels to pixels of the current draw target.
+ */
+float RendererOpenGL::drawScale() const
+{
+	return mIsDrawingScene ? mResolutionScale : 1.0f;
+}
+
+
+void RendererOpenGL::applyViewport()
+{
+	const auto viewport = scaleViewport(mViewport, drawScale());
+	glViewport(viewport.position.x, viewport.position.y, viewport.size.x, viewport.size.y);
+	mViewportSize = viewport.size;
+}
+
+
+/**
+ * Frame buffer drawing currently goes to, which drawing to images must restore.
+ */
+unsigned int RendererOpenGL::drawFrameBufferId() const
+{
+	return mIsDrawingScene ? mSceneTarget.frameBufferId : 0u;
+}
+
+
+void RendererOpenGL::createSceneTarget()
+{
+	mSceneTarget.size = sceneTargetSize(size(), mDynamicResolution->maximumScale);
+
+	glGenTextures(1, &mSceneTarget.textureId);
+	glBindTexture(GL_TEXTURE_2D, mSceneTarget.textureId);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, mSceneTarget.size.x, mSceneTarget.size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+	glGenFramebuffers(1, &mSceneTarget.frameBufferId);
+	glBindFramebuffer(GL_FRAMEBUFFER, mSceneTarget.frameBufferId);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mSceneTarget.textureId, 0);
+	const auto status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, drawFrameBufferId());
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		// Such as on a resize while drawing the scene, which must go to the window instead now
+		disableDynamicResolution();
+		throw std::runtime_error("Dynamic resolution frame buffer is incomplete: " + std::to_string(status));
+	}
+}
+
+
+void RendererOpenGL::deleteSceneTarget()
+{
+	if (mSceneTarget.frameBufferId != 0)
+	{
+		glDeleteFramebuffers(1, &mSceneTarget.frameBufferId);
+	}
+	if (mSceneTarget.textureId != 0)
+	{
+		glDeleteTextures(1, &mSceneTarget.textureId);
+	}
+	mSceneTarget = {};
+}
+
+
+void RendererOpenGL::bindSceneTarget()
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, mSceneTarget.frameBufferId);
+	mIsDrawingScene = true;
+	applyViewport();
+}
+
+
+/**
+ * Draws the scaled scene over the whole window, and directs further drawing to the window.
+ */
+void RendererOpenGL::presentSceneTarget()
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	mIsDrawingScene = false;
+
+	// Drawn in normalized device coordinates, which like texture coordinates start at the bottom
+	const auto uvSize = sceneUvSize(size(), mResolutionScale, mSceneTarget.size);
+
+	glPushAttrib(GL_SCISSOR_BIT);
+	glDisable(GL_SCISSOR_TEST);
+	glViewport(0, 0, size().x, size().y);
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	glLoadIdentity();
+
+	setBlending(false);
+	setColor(Color::White);
+	drawTexturedQuad(mSceneTarget.textureId, rectToQuad({{-1.0f, -1.0f}, {2.0f, 2.0f}}), rectToQuad({{0.0f, 0.0f}, uvSize}));
+
+	glPopMatrix();
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+	glPopAttrib();
+
+	applyViewport();
+}
+
+
+/**
+ * Adjusts the scene resolution towards the target frame time, using the time since the previous frame.
+ */
+void RendererOpenGL::updateResolutionScale()
+{
+	constexpr float smoothing{0.1f};
+
+	const auto frameTime = static_cast<float>(mFrameTimer.delta());
+	mAverageFrameTime += (frameTime - mAverageFrameTime) * smoothing;
+
+	const auto& settings = *mDynamicResolution;
+	mResolutionScale = adjustResolutionScale(mResolutionScale, mAverageFrameTime, static_cast<float>(settings.targetFrameTime), settings.minimumScale, settings.maximumScale);
+}
+
+
+FrameCapture& RendererOpenGL::frameCapture()
+{
+	if (!mFrameCapture)
+	{
+		mFrameCapture = std::make_unique<FrameCapture>();
+	}
+	return *mFrameCapture;
+}
+
+
+/**
+ * Enables or disables blending, skipping the state change if it is already set.
+ */
+void RendererOpenGL::setBlending(bool isBlending)
+{
+	if (isBlending == mIsBlending)
+	{
+		return;
+	}
+
+	if (isBlending)
+	{
+		glEnable(GL_BLEND);
+	}
+	else
+	{
+		glDisable(GL_BLEND);
+	}
+	mIsBlending = isBlending;
+}
+
+
+/**
+ * Draws the tiles of a tiled image that overlap both the source area and the visible area.
+ *
+ * \param	destination	Area to draw to, in the current model view space.
+ * \param	source		Area of the image drawn to the destination.
+ * \param	visible		Part of the model view space that can be seen. Nothing is
+ *						culled if it is null.
+ */
+void RendererOpenGL::drawImageTiles(const Image& image, const Rectangle<float>& destination, const Rectangle<float>& source, const Rectangle<float>& visible)
+{
+	const auto visibleDestination = visible.null() ? destination : intersection(destination, visible);
+	if (visibleDestination.empty() || source.empty())
+	{
+		return;
+	}
+
+	const auto scale = destination.size.skewInverseBy(source.size);
+	const auto visibleSourceStart = source.position + (visibleDestination.position - destination.position).skewInverseBy(scale);
+	const auto visibleSourceEnd = visibleSourceStart + visibleDestination.size.skewInverseBy(scale);
+	const auto region = Rectangle<int>::Create(
+		{static_cast<int>(std::floor(visibleSourceStart.x)), static_cast<int>(std::floor(visibleSourceStart.y))},
+		{static_cast<int>(std::ceil(visibleSourceEnd.x)), static_cast<int>(std::ceil(visibleSourceEnd.y))});
+
+	image.tiles().forEachTile(region, [&](const TiledTexture::Tile& tile) {
+		const auto tileBounds = tile.bounds.to<float>();
+		const auto part = intersection(tileBounds, source);
+		if (part.empty())
+		{
+			return;
+		}
+
+		const auto partDestination = Rectangle{destination.position + (part.position - source.position).skewBy(scale), part.size.skewBy(scale)};
+		const auto uvPerPixel = tile.uvRect.size.skewInverseBy(tileBounds.size);
+		const auto partUv = Rectangle{tile.uvRect.position + (part.position - tileBounds.position).skewBy(uvPerPixel), part.size.skewBy(uvPerPixel)};
+		drawTexturedQuad(tile.textureId, rectToQuad(partDestination), rectToQuad(partUv));
+	});
 }
 
 
@@ -577,6 +1201,21 @@ void RendererOpenGL::initGL()
 	glEnableClientState(GL_VERTEX_ARRAY);
 	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
 
+	// Without shader support distance field text falls back to an alpha test, with hard edges
+	if (GLEW_VERSION_2_0)
+	{
+		try
+		{
+			mDistanceFieldShader = linkShaderProgram(DistanceFieldVertexShader, DistanceFieldFragmentShader);
+		}
+		catch (const std::runtime_error& error)
+		{
+			// Broken drivers can reject valid shaders, which shouldn't stop the game from starting
+			SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "Distance field shader unavailable, using alpha test: %s", error.what());
+			mDistanceFieldShader = 0;
+		}
+	}
+
 	onResize(size());
 }
 
@@ -602,39 +1241,202 @@ void RendererOpenGL::initSdl(Vector<int> resolution, bool fullscreen)
 }
 
 
-void RendererOpenGL::initSdlGL(bool vsync)
+void RendererOpenGL::initSdlGL(bool vsync, bool adaptiveVsync)
 {
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
 	SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
 	SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
 	SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 4);
 
-	SDL_GL_SetSwapInterval(vsync ? 1 : 0);
-
 	sdlOglContext = SDL_GL_CreateContext(underlyingWindow);
 	if (!sdlOglContext)
 	{
 		throw std::runtime_error("Failed to create SDL OpenGL context");
 	}
+
+	// Swap interval applies to the current context, so is set once it exists
+	// Adaptive vsync is an interval of -1, and falls back to regular vsync where unsupported
+	if (!vsync || !adaptiveVsync || SDL_GL_SetSwapInterval(-1) != 0)
+	{
+		SDL_GL_SetSwapInterval(vsync ? 1 : 0);
+	}
 }
 
 
-void RendererOpenGL::initVideo(Vector<int> resolution, bool fullscreen, bool vsync)
+void RendererOpenGL::initVideo(Vector<int> resolution, bool fullscreen, bool vsync, bool adaptiveVsync)
 {
 	initSdl(resolution, fullscreen);
-	initSdlGL(vsync);
+	initSdlGL(vsync, adaptiveVsync);
 	glewInit();
 	initGL();
 
 	Utility<EventHandler>::get().windowResized().connect({this, &RendererOpenGL::onResize});
+	setTextureChangeHandler({this, &RendererOpenGL::onTextureChange});
+}
+
+
+/**
+ * Queues a textured quad, to be drawn together with other quads using the same texture.
+ *
+ * Glyphs of all fonts share atlas pages, so text runs in different fonts and
+ * colors are drawn with a single draw call. Consecutive draws of the same
+ * image, such as frames of a sprite sheet, are batched the same way. The batch
+ * is flushed when the texture or blending changes, and before anything else
+ * is drawn or render state changes.
+ */
+void RendererOpenGL::batchTexturedQuad(unsigned int textureId, const std::array<float, 12>& verticies, const std::array<float, 12>& textureCoords, Color color, bool isDistanceField, bool isBlended)
+{
+	if (textureId != mQuadBatch.textureId || isDistanceField != mQuadBatch.isDistanceField || isBlended != mQuadBatch.isBlended)
+	{
+		flushBatch();
+		mQuadBatch.textureId = textureId;
+		mQuadBatch.isDistanceField = isDistanceField;
+		mQuadBatch.isBlended = isBlended;
+	}
+
+	mQuadBatch.verticies.insert(mQuadBatch.verticies.end(), verticies.begin(), verticies.end());
+	mQuadBatch.textureCoords.insert(mQuadBatch.textureCoords.end(), textureCoords.begin(), textureCoords.end());
+	mQuadBatch.colors.insert(mQuadBatch.colors.end(), verticies.size() / 2, color);
+}
+
+
+/**
+ * Queues a quad of a non-tiled image.
+ */
+void RendererOpenGL::batchImageQuad(const Image& image, const std::array<float, 12>& verticies, const std::array<float, 12>& textureCoords, Color color, bool isMinified)
+{
+	const auto textureId = image.textureId();
+	// The filter applies to every quad of the texture, so quads already queued are drawn first
+	if (textureId == mQuadBatch.textureId && image.changesMinificationFilter(isMinified))
+	{
+		flushBatch();
+	}
+	image.setMinificationFilter(isMinified);
+
+	batchTexturedQuad(textureId, verticies, textureCoords, color, false, needsBlending(image, color));
+}
+
+
+/**
+ * Draws queued quads that use a texture, before the texture is deleted or its pixels change.
+ */
+void RendererOpenGL::onTextureChange(unsigned int textureId)
+{
+	if (mQuadBatch.textureId == textureId)
+	{
+		flushBatch();
+	}
+}
+
+
+void RendererOpenGL::flushBatch()
+{
+	if (mQuadBatch.verticies.empty()) { return; }
+
+	setBlending(mQuadBatch.isBlended);
+
+	glBindTexture(GL_TEXTURE_2D, mQuadBatch.textureId);
+	glEnableClientState(GL_COLOR_ARRAY);
+
+	if (mQuadBatch.isDistanceField)
+	{
+		if (mDistanceFieldShader != 0)
+		{
+			glUseProgram(mDistanceFieldShader);
+		}
+		else
+		{
+			glEnable(GL_ALPHA_TEST);
+			glAlphaFunc(GL_GEQUAL, 0.5f);
+		}
+	}
+
+	glVertexPointer(2, GL_FLOAT, 0, mQuadBatch.verticies.data());
+	glTexCoordPointer(2, GL_FLOAT, 0, mQuadBatch.textureCoords.data());
+	glColorPointer(4, GL_UNSIGNED_BYTE, 0, mQuadBatch.colors.data());
+	// Quads are stored as two separate triangles, so they can be drawn together
+	glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(mQuadBatch.colors.size()));
+
+	glDisableClientState(GL_COLOR_ARRAY);
+
+	if (mQuadBatch.isDistanceField)
+	{
+		if (mDistanceFieldShader != 0)
+		{
+			glUseProgram(0);
+		}
+		glDisable(GL_ALPHA_TEST);
+	}
+
+	mQuadBatch.verticies.clear();
+	mQuadBatch.textureCoords.clear();
+	mQuadBatch.colors.clear();
 }
 
+
 // ==================================================================================
 // = NON PUBLIC IMPLEMENTATION
 // ==================================================================================
 
 namespace
 {
+	GLuint compileShader(GLenum shaderType, const char* source)
+	{
+		const auto shader = glCreateShader(shaderType);
+		glShaderSource(shader, 1, &source, nullptr);
+		glCompileShader(shader);
+
+		GLint status;
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+		if (status != GL_TRUE)
+		{
+			GLchar log[1024]{};
+			glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+			glDeleteShader(shader);
+			throw std::runtime_error("Shader compile failed: " + std::string{log});
+		}
+
+		return shader;
+	}
+
+
+	GLuint linkShaderProgram(const char* vertexSource, const char* fragmentSource)
+	{
+		const auto vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
+		GLuint fragmentShader;
+		try
+		{
+			fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
+		}
+		catch (const std::runtime_error&)
+		{
+			glDeleteShader(vertexShader);
+			throw;
+		}
+
+		const auto program = glCreateProgram();
+		glAttachShader(program, vertexShader);
+		glAttachShader(program, fragmentShader);
+		glLinkProgram(program);
+
+		// Shaders are freed along with the program
+		glDeleteShader(vertexShader);
+		glDeleteShader(fragmentShader);
+
+		GLint status;
+		glGetProgramiv(program, GL_LINK_STATUS, &status);
+		if (status != GL_TRUE)
+		{
+			GLchar log[1024]{};
+			glGetProgramInfoLog(program, sizeof(log), nullptr, log);
+			glDeleteProgram(program);
+			throw std::runtime_error("Shader link failed: " + std::string{log});
+		}
+
+		return program;
+	}
+
+
 	void drawTexturedQuad(GLuint textureId, const std::array<GLfloat, 12>& verticies, const std::array<GLfloat, 12>& textureCoords)
 	{
 		glBindTexture(GL_TEXTURE_2D, textureId);
@@ -10,8 +10,14 @@
 #pragma once
 
 #include "Renderer.h"
+#include "../Math/Rectangle.h"
+#include "../Timer.h"
 
+#include <array>
+#include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 
 using SDL_GLContext = void*;
@@ -19,6 +25,9 @@ using SDL_GLContext = void*;
 
 namespace NAS2D
 {
+	class FrameCapture;
+
+
 	class RendererOpenGL : public Renderer
 	{
 	public:
@@ -27,6 +36,21 @@ namespace NAS2D
 			Vector<int> resolution;
 			bool fullscreen;
 			bool vsync;
+			// Lets late frames swap immediately rather than wait a whole refresh, where supported
+			bool adaptiveVsync{false};
+		};
+
+		/**
+		 * Bounds for dynamic resolution scaling.
+		 *
+		 * With vsync, frame time can't drop below the display refresh interval,
+		 * so the target should be a little above it, such as 17 ms at 60 Hz.
+		 */
+		struct DynamicResolution
+		{
+			float minimumScale;
+			float maximumScale;
+			unsigned int targetFrameTime;
 		};
 
 		static Options ReadConfigurationOptions();
@@ -46,6 +70,12 @@ namespace NAS2D
 		std::string getDriverVersion();
 		std::string getShaderVersion();
 
+		void enableDynamicResolution(const DynamicResolution& settings);
+		void disableDynamicResolution();
+		bool isDynamicResolutionEnabled() const;
+		float resolutionScale() const;
+		void beginOverlay();
+
 		void drawImage(const Image& image, Point<float> position, float scale = 1.0, Color color = Color::Normal) override;
 
 		void drawSubImage(const Image& image, Point<float> raster, const Rectangle<float>& subImageRect, Color color = Color::Normal) override;
@@ -64,10 +94,12 @@ namespace NAS2D
 		void drawBox(const Rectangle<float>& rect, Color color = Color::White) override;
 		void drawBoxFilled(const Rectangle<float>& rect, Color color = Color::White) override;
 		void drawCircle(Point<float> position, float radius, Color color, int num_segments = 10, Vector<float> scale = Vector{1.0f, 1.0f}) override;
+		void drawPathMesh(const PathMesh& mesh, Point<float> position = {0, 0}, Color color = Color::White) override;
 
 		void drawGradient(const Rectangle<float>& rect, Color c1, Color c2, Color c3, Color c4) override;
 
-		void drawText(const Font& font, std::string_view text, Point<float> position, Color color = Color::White) override;
+		void drawText(const Font& font, std::string_view text, Point<float> position, Color color = Color::White, float scale = 1.0f) override;
+		void drawTextToImage(const Font& font, std::string_view text, const Image& destination, Point<float> dstPoint, Color color = Color::White) override;
 
 		void clearScreen(Color color = Color::Black) override;
 
@@ -76,18 +108,74 @@ namespace NAS2D
 
 		void update() override;
 
+		void captureFrameAsync(FrameCaptureCallback callback) override;
+		void captureFrameAsync(const std::filesystem::path& filename) override;
+		void startFrameDump(const std::filesystem::path& directory) override;
+		void stopFrameDump() override;
+
 		void setViewport(const Rectangle<int>& viewport) override;
 		void setOrthoProjection(const Rectangle<float>& orthoBounds) override;
 
 	private:
 		void initGL();
 		void initSdl(Vector<int> resolution, bool fullscreen);
-		void initSdlGL(bool vsync);
-		void initVideo(Vector<int> resolution, bool fullscreen, bool vsync);
+		void initSdlGL(bool vsync, bool adaptiveVsync);
+		void initVideo(Vector<int> resolution, bool fullscreen, bool vsync, bool adaptiveVsync);
 
 		void onResize(Vector<int> newSize) override;
+		void onTextureChange(unsigned int textureId);
+
+		bool isMinified(Vector<float> drawnSize, Vector<float> sourceSize) const;
+		float drawScale() const;
+		void applyViewport();
+		unsigned int drawFrameBufferId() const;
+		void setBlending(bool isBlending);
+		void drawImageTiles(const Image& image, const Rectangle<float>& destination, const Rectangle<float>& source, const Rectangle<float>& visible);
 
+		void createSceneTarget();
+		void deleteSceneTarget();
+		void bindSceneTarget();
+		void presentSceneTarget();
+		void updateResolutionScale();
+		FrameCapture& frameCapture();
+
+		void batchTexturedQuad(unsigned int textureId, const std::array<float, 12>& verticies, const std::array<float, 12>& textureCoords, Color color, bool isDistanceField, bool isBlended = true);
+		void batchImageQuad(const Image& image, const std::array<float, 12>& verticies, const std::array<float, 12>& textureCoords, Color color, bool isMinified);
+		void flushBatch();
+
+
+		struct QuadBatch
+		{
+			unsigned int textureId{0u};
+			bool isDistanceField{false};
+			bool isBlended{true};
+			std::vector<float> verticies{};
+			std::vector<float> textureCoords{};
+			std::vector<Color> colors{};
+		};
 
 		SDL_GLContext sdlOglContext{};
+		// Offscreen target the scene is drawn to with dynamic resolution, sized for the maximum scale
+		struct SceneTarget
+		{
+			unsigned int frameBufferId{0u};
+			unsigned int textureId{0u};
+			Vector<int> size{};
+		};
+
+		QuadBatch mQuadBatch{};
+		unsigned int mDistanceFieldShader{0u};
+		bool mIsBlending{true};
+		Rectangle<int> mViewport{};
+		Vector<int> mViewportSize{};
+		Rectangle<float> mOrthoBounds{};
+		std::optional<DynamicResolution> mDynamicResolution{};
+		SceneTarget mSceneTarget{};
+		bool mIsDrawingScene{false};
+		float mResolutionScale{1.0f};
+		float mAverageFrameTime{0.0f};
+		Timer mFrameTimer{};
+		// Created on the first capture, so renderers that never capture have no worker thread
+		std::unique_ptr<FrameCapture> mFrameCapture{};
 	};
 } // namespace NAS2D
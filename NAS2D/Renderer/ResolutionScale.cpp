@@ -0,0 +1,83 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+
+#include "ResolutionScale.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+using namespace NAS2D;
+
+
+namespace
+{
+	int scaled(int value, float scale)
+	{
+		return static_cast<int>(std::lround(static_cast<float>(value) * scale));
+	}
+}
+
+
+/**
+ * Viewport in pixels of a draw target scaled from the window, of at least one pixel.
+ */
+Rectangle<int> NAS2D::scaleViewport(const Rectangle<int>& viewport, float scale)
+{
+	return {
+		{scaled(viewport.position.x, scale), scaled(viewport.position.y, scale)},
+		{std::max(scaled(viewport.size.x, scale), 1), std::max(scaled(viewport.size.y, scale), 1)},
+	};
+}
+
+
+/**
+ * Size of the scene target, large enough for the scene at the largest scale.
+ */
+Vector<int> NAS2D::sceneTargetSize(Vector<int> windowSize, float maximumScale)
+{
+	const auto size = windowSize.to<float>();
+	return {std::max(static_cast<int>(std::ceil(size.x * maximumScale)), 1), std::max(static_cast<int>(std::ceil(size.y * maximumScale)), 1)};
+}
+
+
+/**
+ * Texture coordinates of the part of the scene target drawn to at a scale.
+ *
+ * Rounded as scaleViewport() rounds, so the upscaled scene covers exactly what was drawn.
+ */
+Vector<float> NAS2D::sceneUvSize(Vector<int> windowSize, float scale, Vector<int> targetSize)
+{
+	const auto sceneSize = Vector{scaled(windowSize.x, scale), scaled(windowSize.y, scale)}.to<float>();
+	return sceneSize.skewInverseBy(targetSize.to<float>());
+}
+
+
+/**
+ * Steps the scale towards the target frame time.
+ *
+ * Pixel count is proportional to the square of the scale, so the scale is
+ * adjusted by the square root of the frame time ratio. Steps are limited, and
+ * a band below the target is left alone, so the scale settles instead of
+ * oscillating.
+ */
+float NAS2D::adjustResolutionScale(float scale, float averageFrameTime, float targetFrameTime, float minimumScale, float maximumScale)
+{
+	constexpr float settledFraction{0.85f};
+
+	if (averageFrameTime <= targetFrameTime && averageFrameTime >= targetFrameTime * settledFraction)
+	{
+		return scale;
+	}
+
+	const auto step = std::clamp(std::sqrt(targetFrameTime / std::max(averageFrameTime, 1.0f)), 0.9f, 1.05f);
+	return std::clamp(scale * step, minimumScale, maximumScale);
+}
@@ -0,0 +1,31 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include "../Math/Rectangle.h"
+#include "../Math/Vector.h"
+
+
+namespace NAS2D
+{
+	/**
+	 * Layout math of dynamic resolution, where the scene is drawn at a fraction
+	 * of the window size into a scene target, then upscaled to the window.
+	 *
+	 * Kept apart from RendererOpenGL so it can be tested without a GL context.
+	 */
+
+	Rectangle<int> scaleViewport(const Rectangle<int>& viewport, float scale);
+	Vector<int> sceneTargetSize(Vector<int> windowSize, float maximumScale);
+	Vector<float> sceneUvSize(Vector<int> windowSize, float scale, Vector<int> targetSize);
+	float adjustResolutionScale(float scale, float averageFrameTime, float targetFrameTime, float minimumScale, float maximumScale);
+
+} // namespace NAS2D
@@ -0,0 +1,149 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "TextCache.h"
+
+#include "Renderer.h"
+#include "../Resource/Font.h"
+#include "../Utility.h"
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <tuple>
+#include <stdexcept>
+
+
+using namespace NAS2D;
+
+
+namespace
+{
+	constexpr std::size_t BytesPerPixel{4};
+
+
+	SDL_Surface* createBlankSurface(Vector<int> size)
+	{
+		// Surface memory is zero filled, which is fully transparent
+		auto* surface = SDL_CreateRGBSurfaceWithFormat(0, size.x, size.y, 32, SDL_PIXELFORMAT_RGBA32);
+		if (!surface)
+		{
+			throw std::runtime_error("TextCache failed to create surface: " + std::string{SDL_GetError()});
+		}
+		return surface;
+	}
+}
+
+
+bool TextCache::Key::operator<(const Key& other) const
+{
+	return std::tie(fontId, text, color.red, color.green, color.blue, color.alpha) <
+		std::tie(other.fontId, other.text, other.color.red, other.color.green, other.color.blue, other.color.alpha);
+}
+
+
+/**
+ * \param	memoryLimit	Maximum number of bytes of baked Image data to keep.
+ */
+TextCache::TextCache(std::size_t memoryLimit) :
+	mCache{memoryLimit}
+{
+}
+
+
+/**
+ * Gets an Image with the text pre-rendered, baking it on first use.
+ *
+ * \param	font	Font to render the text with.
+ * \param	text	Text to render.
+ * \param	color	Color of the text. The color is baked into the Image.
+ */
+const Image& TextCache::image(const Font& font, std::string_view text, Color color)
+{
+	auto key = Key{font.id(), std::string{text}, color};
+	if (const auto* cachedImage = mCache.find(key))
+	{
+		return *cachedImage;
+	}
+
+	const auto imageSize = Vector{std::max(font.width(text), 1), std::max(font.height(), 1)};
+	const auto cost = static_cast<std::size_t>(imageSize.x) * static_cast<std::size_t>(imageSize.y) * BytesPerPixel;
+	const auto& image = mCache.emplace(key, cost, *createBlankSurface(imageSize));
+
+	Utility<Renderer>::get().drawTextToImage(font, text, image, {0, 0}, color);
+	return image;
+}
+
+
+/**
+ * Draws text using a cached pre-rendered Image.
+ *
+ * Output matches Renderer::drawText, but costs a single quad after the first call.
+ */
+void TextCache::drawText(const Font& font, std::string_view text, Point<float> position, Color color)
+{
+	if (text.empty()) { return; }
+
+	Utility<Renderer>::get().drawImage(image(font, text, color), position);
+}
+
+
+/**
+ * Removes all cached entries rendered with the given Font.
+ */
+void TextCache::unload(const Font& font)
+{
+	mCache.eraseIf([fontId = font.id()](const Key& key) { return key.fontId == fontId; });
+}
+
+
+void TextCache::clear()
+{
+	mCache.clear();
+}
+
+
+void TextCache::memoryLimit(std::size_t newMemoryLimit)
+{
+	mCache.capacity(newMemoryLimit);
+}
+
+
+std::size_t TextCache::memoryLimit() const
+{
+	return mCache.capacity();
+}
+
+
+/**
+ * Number of bytes of baked Image data currently held.
+ */
+std::size_t TextCache::memoryUsage() const
+{
+	return mCache.usage();
+}
+
+
+std::size_t TextCache::size() const
+{
+	return mCache.size();
+}
+
+
+std::size_t TextCache::hits() const
+{
+	return mCache.hits();
+}
+
+
+std::size_t TextCache::misses() const
+{
+	return mCache.misses();
+}
@@ -0,0 +1,77 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include "Color.h"
+#include "../Math/Point.h"
+#include "../Resource/Image.h"
+#include "../Resource/LruCache.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+
+namespace NAS2D
+{
+	class Font;
+
+
+	/**
+	 * Cache of text strings pre-rendered to Images.
+	 *
+	 * Text drawn with Renderer::drawText costs one quad per glyph per frame. For
+	 * labels that rarely change (building names, menu items, etc.) the TextCache
+	 * renders the string once into an Image, and then draws it as a single quad.
+	 *
+	 * Entries are keyed by Font, text and color, and are evicted in least recently
+	 * used order once the memory used by the baked Images exceeds the memory limit.
+	 *
+	 * Fonts are identified by Font::id(), so entries of a destroyed Font are never
+	 * used for another. They stay until evicted, or until unload() frees them early.
+	 */
+	class TextCache
+	{
+	public:
+		static constexpr std::size_t DefaultMemoryLimit{8 * 1024 * 1024};
+
+		explicit TextCache(std::size_t memoryLimit = DefaultMemoryLimit);
+		TextCache(const TextCache&) = delete;
+		TextCache& operator=(const TextCache&) = delete;
+
+		const Image& image(const Font& font, std::string_view text, Color color = Color::White);
+		void drawText(const Font& font, std::string_view text, Point<float> position, Color color = Color::White);
+
+		void unload(const Font& font);
+		void clear();
+
+		void memoryLimit(std::size_t newMemoryLimit);
+		std::size_t memoryLimit() const;
+		std::size_t memoryUsage() const;
+		std::size_t size() const;
+
+		std::size_t hits() const;
+		std::size_t misses() const;
+
+	private:
+		struct Key
+		{
+			uint64_t fontId;
+			std::string text;
+			Color color;
+
+			bool operator<(const Key& other) const;
+		};
+
+		LruCache<Key, Image> mCache;
+	};
+} // namespace
@@ -0,0 +1,39 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "TextureChange.h"
+
+
+using namespace NAS2D;
+
+
+namespace
+{
+	// Not a Signal, as textures can be deleted during static destruction, after a Signal would be destroyed
+	TextureChangeHandler textureChangeHandler{};
+}
+
+
+/**
+ * Sets the handler called by beforeTextureChange(), or clears it when passed an empty handler.
+ */
+void NAS2D::setTextureChangeHandler(TextureChangeHandler handler)
+{
+	textureChangeHandler = handler;
+}
+
+
+void NAS2D::beforeTextureChange(unsigned int textureId)
+{
+	if (textureChangeHandler && textureId != 0)
+	{
+		textureChangeHandler(textureId);
+	}
+}
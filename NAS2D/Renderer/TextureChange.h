@@ -0,0 +1,30 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include "../Signal/Delegate.h"
+
+
+namespace NAS2D
+{
+	/**
+	 * Called with a texture id before the texture is deleted or its pixels
+	 * change, so drawing queued with the texture can be finished first.
+	 *
+	 * Registered by the renderer, which batches quads by texture. Code that
+	 * deletes or updates textures calls beforeTextureChange(), which does
+	 * nothing while no renderer exists.
+	 */
+	using TextureChangeHandler = Delegate<void(unsigned int)>;
+
+	void setTextureChangeHandler(TextureChangeHandler handler);
+	void beforeTextureChange(unsigned int textureId);
+} // namespace NAS2D
@@ -0,0 +1,260 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "TextureUploadThread.h"
+
+#include "../Resource/Image.h"
+
+#if defined(__XCODE_BUILD__)
+#include <GLEW/GLEW.h>
+#include <SDL2/SDL.h>
+#else
+#include <GL/glew.h>
+#include <SDL2/SDL.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+
+
+using namespace NAS2D;
+
+
+extern SDL_Window* underlyingWindow;
+
+
+namespace
+{
+	// Long enough for any upload to finish, short enough to notice a lost context
+	constexpr GLuint64 FenceTimeoutNanoseconds{1'000'000'000};
+	// Waits on a fence before falling back to glFinish, for drivers that never signal it
+	constexpr int MaxFenceWaits{5};
+
+
+	void waitForUpload()
+	{
+		auto isFinished = false;
+		if (GLEW_ARB_sync)
+		{
+			auto fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			if (fence)
+			{
+				// Commands only need flushing once, later waits would flush nothing new
+				auto result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceTimeoutNanoseconds);
+				for (int waitCount = 1; result == GL_TIMEOUT_EXPIRED && waitCount < MaxFenceWaits; ++waitCount)
+				{
+					result = glClientWaitSync(fence, 0, FenceTimeoutNanoseconds);
+				}
+				isFinished = (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED);
+				glDeleteSync(fence);
+			}
+		}
+
+		// The texture must be complete before the main thread draws with it
+		if (!isFinished)
+		{
+			glFinish();
+		}
+	}
+}
+
+
+TextureUploadThread::TextureUploadThread()
+{
+	auto* mainContext = SDL_GL_GetCurrentContext();
+	if (!underlyingWindow || !mainContext)
+	{
+		return;
+	}
+
+	SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+	mContext = SDL_GL_CreateContext(underlyingWindow);
+	SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 0);
+
+	// Creating a context makes it current, so switch back to the main context
+	SDL_GL_MakeCurrent(underlyingWindow, mainContext);
+
+	if (!mContext)
+	{
+		return;
+	}
+
+	std::promise<bool> started;
+	auto isStarted = started.get_future();
+	mThread = std::thread{&TextureUploadThread::run, this, std::move(started)};
+	if (!isStarted.get())
+	{
+		mThread.join();
+	}
+}
+
+
+TextureUploadThread::~TextureUploadThread()
+{
+	if (mThread.joinable())
+	{
+		{
+			const std::lock_guard lock{mMutex};
+			mStop = true;
+		}
+		mCondition.notify_one();
+		mThread.join();
+	}
+
+	for (const auto* image : mPending)
+	{
+		image->mUploadThread = nullptr;
+	}
+	for (const auto& [image, textureId] : mReady)
+	{
+		image->mUploadThread = nullptr;
+		glDeleteTextures(1, &textureId);
+	}
+
+	if (mContext)
+	{
+		SDL_GL_DeleteContext(mContext);
+	}
+}
+
+
+/**
+ * Whether uploads run on the loader thread, rather than falling back to the main thread.
+ */
+bool TextureUploadThread::isThreaded() const
+{
+	return mThread.joinable();
+}
+
+
+void TextureUploadThread::push(const Image& image)
+{
+	// Tiled images upload their tiles as they are drawn
+	if (image.isUploaded() || image.isTiled())
+	{
+		return;
+	}
+
+	{
+		const std::lock_guard lock{mMutex};
+		if (std::find(mPending.begin(), mPending.end(), &image) != mPending.end())
+		{
+			return;
+		}
+		mPending.push_back(&image);
+		image.mUploadThread = this;
+	}
+	mCondition.notify_one();
+}
+
+
+/**
+ * Removes an image from the queue, such as before it is destroyed.
+ *
+ * Waits if the image is being uploaded at the time.
+ */
+void TextureUploadThread::cancel(const Image& image)
+{
+	std::unique_lock lock{mMutex};
+	mUploadFinished.wait(lock, [this, &image]() { return mUploading != &image; });
+	if (image.mUploadThread == this)
+	{
+		image.mUploadThread = nullptr;
+	}
+
+	mPending.erase(std::remove(mPending.begin(), mPending.end(), &image), mPending.end());
+
+	const auto isImage = [&image](const auto& ready) { return ready.first == &image; };
+	for (const auto& [readyImage, textureId] : mReady)
+	{
+		if (readyImage == &image)
+		{
+			glDeleteTextures(1, &textureId);
+		}
+	}
+	mReady.erase(std::remove_if(mReady.begin(), mReady.end(), isImage), mReady.end());
+}
+
+
+/**
+ * Hands finished textures to their images. Call once per frame from the main thread.
+ */
+void TextureUploadThread::update()
+{
+	if (!isThreaded())
+	{
+		std::deque<const Image*> pending;
+		{
+			const std::lock_guard lock{mMutex};
+			std::swap(pending, mPending);
+		}
+		for (const auto* image : pending)
+		{
+			image->mUploadThread = nullptr;
+			image->upload();
+		}
+		return;
+	}
+
+	std::vector<std::pair<const Image*, unsigned int>> ready;
+	{
+		const std::lock_guard lock{mMutex};
+		std::swap(ready, mReady);
+	}
+	for (const auto& [image, textureId] : ready)
+	{
+		image->mUploadThread = nullptr;
+		image->adoptTexture(textureId);
+	}
+}
+
+
+bool TextureUploadThread::empty() const
+{
+	const std::lock_guard lock{mMutex};
+	return mPending.empty() && mReady.empty();
+}
+
+
+void TextureUploadThread::run(std::promise<bool> started)
+{
+	if (SDL_GL_MakeCurrent(underlyingWindow, mContext) != 0)
+	{
+		started.set_value(false);
+		return;
+	}
+	started.set_value(true);
+
+	while (true)
+	{
+		std::unique_lock lock{mMutex};
+		mCondition.wait(lock, [this]() { return mStop || !mPending.empty(); });
+		if (mStop)
+		{
+			break;
+		}
+
+		mUploading = mPending.front();
+		mPending.pop_front();
+		lock.unlock();
+
+		// If the image is drawn meanwhile, the main thread uploads it too and adoptTexture discards this one
+		const auto textureId = mUploading->createTexture();
+		waitForUpload();
+
+		lock.lock();
+		mReady.emplace_back(mUploading, textureId);
+		mUploading = nullptr;
+		lock.unlock();
+		mUploadFinished.notify_all();
+	}
+
+	SDL_GL_MakeCurrent(underlyingWindow, nullptr);
+}
@@ -0,0 +1,78 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+using SDL_GLContext = void*;
+
+
+namespace NAS2D
+{
+	class Image;
+
+
+	/**
+	 * Uploads textures on a loader thread with its own GL context.
+	 *
+	 * The loader context shares objects with the main context, so textures it
+	 * creates can be drawn by the renderer. Each upload is fenced, and only handed
+	 * to the image once the GPU has finished with it, so update() never stalls.
+	 *
+	 * When a shared context can't be created, images are uploaded on the main
+	 * thread during update() instead.
+	 *
+	 * \note	Must be constructed on the main thread after the renderer, and
+	 *			destroyed before it.
+	 * \note	Queued images remove themselves when destroyed, drawn, or when
+	 *			their pixels are replaced, waiting for an upload in progress.
+	 *			Other changes to a queued image, such as its texture format, must
+	 *			wait until it is uploaded.
+	 */
+	class TextureUploadThread
+	{
+	public:
+		TextureUploadThread();
+		TextureUploadThread(const TextureUploadThread&) = delete;
+		TextureUploadThread& operator=(const TextureUploadThread&) = delete;
+		~TextureUploadThread();
+
+		bool isThreaded() const;
+
+		void push(const Image& image);
+		void cancel(const Image& image);
+
+		void update();
+
+		bool empty() const;
+
+	private:
+		void run(std::promise<bool> started);
+
+		SDL_GLContext mContext{nullptr};
+		std::thread mThread{};
+
+		mutable std::mutex mMutex{};
+		std::condition_variable mCondition{};
+		std::condition_variable mUploadFinished{};
+		bool mStop{false};
+		std::deque<const Image*> mPending{};
+		const Image* mUploading{nullptr};
+		std::vector<std::pair<const Image*, unsigned int>> mReady{};
+	};
+} // namespace NAS2D
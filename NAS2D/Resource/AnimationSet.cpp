@@ -31,7 +31,20 @@ namespace
 	constexpr std::string_view SPRITE_VERSION{"0.99"};
 
 	using ImageCache = ResourceCache<Image, std::string>;
-	ImageCache animationImageCache;
+
+	// Sprite sheets are often copied between sprite folders
+	ImageCache createAnimationImageCache()
+	{
+		ImageCache imageCache;
+		imageCache.shareIdenticalContent(
+			Image::fileContentHash,
+			Image::decodedByteCount,
+			[](const ImageCache::Key& key1, const ImageCache::Key& key2) { return Image::fileContentEqual(std::get<0>(key1), std::get<0>(key2)); }
+		);
+		return imageCache;
+	}
+
+	ImageCache animationImageCache = createAnimationImageCache();
 
 
 	// Adds a row tag to the end of messages.
@@ -61,6 +74,15 @@ bool AnimationSet::Frame::isStopFrame() const
 }
 
 
+/**
+ * Loads that shared an image with an identical file, and the decoded bytes saved, for animations using the default image cache.
+ */
+AnimationSet::ImageCacheStats AnimationSet::imageCacheStats()
+{
+	return {animationImageCache.sharedCount(), animationImageCache.sharedBytes()};
+}
+
+
 AnimationSet::AnimationSet(std::string fileName) :
 	AnimationSet{std::move(fileName), animationImageCache}
 {
@@ -276,7 +298,9 @@ namespace
 			}
 
 			const auto anchorOffset = Vector{anchorx, anchory};
-			frameList.push_back(AnimationSet::Frame{image, frameRect, anchorOffset, delay});
+			const auto opaqueRect = image.pixels().opaqueBounds(frameRect);
+			const auto opaqueAnchorOffset = anchorOffset - (opaqueRect.position - frameRect.position);
+			frameList.push_back(AnimationSet::Frame{image, frameRect, anchorOffset, delay, opaqueRect, opaqueAnchorOffset});
 		}
 
 		return frameList;
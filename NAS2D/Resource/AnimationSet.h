@@ -14,6 +14,7 @@
 #include "../Math/Vector.h"
 #include "../Math/Rectangle.h"
 
+#include <cstddef>
 #include <map>
 #include <vector>
 #include <string>
@@ -34,13 +35,25 @@ namespace NAS2D
 			Rectangle<int> bounds;
 			Vector<int> anchorOffset;
 			unsigned int frameDelay;
+			// Frame area without its transparent margins, and the anchor offset relative to it
+			Rectangle<int> opaqueBounds = bounds;
+			Vector<int> opaqueAnchorOffset = anchorOffset;
 
 			bool isStopFrame() const;
 		};
 
+		// Images shared between identical sprite sheet files, in the default image cache
+		struct ImageCacheStats
+		{
+			std::size_t sharedCount;
+			std::size_t sharedBytes;
+		};
+
 		using ImageSheetMap = std::map<std::string, std::string>;
 		using ActionsMap = std::map<std::string, std::vector<Frame>>;
 
+		static ImageCacheStats imageCacheStats();
+
 
 		explicit AnimationSet(std::string fileName);
 		AnimationSet(std::string fileName, ResourceCache<Image, std::string>& imageCache);
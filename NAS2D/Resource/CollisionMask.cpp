@@ -0,0 +1,230 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "CollisionMask.h"
+
+#include "Image.h"
+#include "ImagePixels.h"
+#include "PixelKernels.h"
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+
+using namespace NAS2D;
+
+
+namespace
+{
+	constexpr std::size_t WordBits{64};
+
+
+	std::string rectToString(const Rectangle<int>& rect)
+	{
+		return "{" + std::to_string(rect.position.x) + ", " + std::to_string(rect.position.y) + ", " + std::to_string(rect.size.x) + ", " + std::to_string(rect.size.y) + "}";
+	}
+}
+
+
+/**
+ * Builds masks for animation frames, thresholding each distinct image only once.
+ *
+ * Frames cut from the same sprite sheet share a single pass over its pixels.
+ */
+std::vector<CollisionMask> CollisionMask::fromFrames(const std::vector<AnimationSet::Frame>& frames, uint8_t alphaThreshold)
+{
+	std::map<const Image*, CollisionMask> sheetMasks;
+	std::vector<CollisionMask> masks;
+	masks.reserve(frames.size());
+
+	for (const auto& frame : frames)
+	{
+		auto iter = sheetMasks.find(&frame.image);
+		if (iter == sheetMasks.end())
+		{
+			iter = sheetMasks.try_emplace(&frame.image, frame.image, alphaThreshold).first;
+		}
+		masks.push_back(iter->second.subMask(frame.bounds));
+	}
+
+	return masks;
+}
+
+
+/**
+ * Creates a mask with no solid pixels.
+ */
+CollisionMask::CollisionMask(Vector<int> size) :
+	mSize{std::max(size.x, 0), std::max(size.y, 0)},
+	mWordsPerRow{(static_cast<std::size_t>(mSize.x) + WordBits - 1) / WordBits},
+	mRowStride{mWordsPerRow + 2},
+	mWords(mRowStride * static_cast<std::size_t>(mSize.y), 0)
+{
+}
+
+
+/**
+ * Creates a mask of an area of locked image pixels.
+ *
+ * \param	pixels			Pixels of the image.
+ * \param	rect			Area of the image to build the mask from.
+ * \param	alphaThreshold	Largest alpha of pixels that are not solid.
+ */
+CollisionMask::CollisionMask(const ImagePixels& pixels, const Rectangle<int>& rect, uint8_t alphaThreshold) :
+	CollisionMask{rect.size}
+{
+	if (!Rectangle{{0, 0}, pixels.size()}.contains(rect) || rect.size.x < 0 || rect.size.y < 0)
+	{
+		throw std::runtime_error("CollisionMask area out of bounds: " + rectToString(rect));
+	}
+
+	const auto width = static_cast<std::size_t>(mSize.x);
+	std::vector<uint8_t> alpha(width);
+	for (int y = 0; y < mSize.y; ++y)
+	{
+		const auto source = pixels.row(rect.position.y + y).subspan(static_cast<std::size_t>(rect.position.x), width);
+		extractChannel(source.data(), alpha.data(), width, ColorChannel::Alpha);
+		packThresholdBits(alpha.data(), row(y), width, alphaThreshold);
+	}
+}
+
+
+CollisionMask::CollisionMask(const Image& image, uint8_t alphaThreshold) :
+	CollisionMask{image.pixels(), {{0, 0}, image.size()}, alphaThreshold}
+{
+}
+
+
+CollisionMask::CollisionMask(const AnimationSet::Frame& frame, uint8_t alphaThreshold) :
+	CollisionMask{frame.image.pixels(), frame.bounds, alphaThreshold}
+{
+}
+
+
+Vector<int> CollisionMask::size() const
+{
+	return mSize;
+}
+
+
+/**
+ * Whether a pixel is solid. Points outside the mask are not.
+ */
+bool CollisionMask::contains(Point<int> point) const
+{
+	if (!Rectangle{{0, 0}, mSize}.contains(point))
+	{
+		return false;
+	}
+
+	const auto x = static_cast<std::size_t>(point.x);
+	return (row(point.y)[x / WordBits] >> (x % WordBits)) & 1;
+}
+
+
+void CollisionMask::set(Point<int> point, bool isSolid)
+{
+	if (!Rectangle{{0, 0}, mSize}.contains(point))
+	{
+		throw std::runtime_error("CollisionMask point out of bounds: {" + std::to_string(point.x) + ", " + std::to_string(point.y) + "}");
+	}
+
+	const auto x = static_cast<std::size_t>(point.x);
+	const auto bit = uint64_t{1} << (x % WordBits);
+	auto& word = row(point.y)[x / WordBits];
+	word = isSolid ? (word | bit) : (word & ~bit);
+}
+
+
+/**
+ * Whether any solid pixels of two masks overlap.
+ *
+ * \param	other	Mask to test against.
+ * \param	offset	Position of the other mask relative to this one.
+ */
+bool CollisionMask::overlaps(const CollisionMask& other, Vector<int> offset) const
+{
+	// Bits of the mask further right are shifted, so shifts are always towards higher bits
+	if (offset.x < 0)
+	{
+		return other.overlaps(*this, {-offset.x, -offset.y});
+	}
+
+	const auto startY = std::max(offset.y, 0);
+	const auto endY = std::min(mSize.y, offset.y + other.mSize.y);
+	if (offset.x >= mSize.x || other.mSize.x == 0 || startY >= endY)
+	{
+		return false;
+	}
+
+	const auto wordShift = static_cast<std::size_t>(offset.x) / WordBits;
+	const auto bitShift = static_cast<unsigned int>(static_cast<std::size_t>(offset.x) % WordBits);
+	// Shifted bits can spill into the word after the last word of the other mask
+	const auto endWord = std::min(mWordsPerRow, wordShift + other.mWordsPerRow + 1);
+
+	for (int y = startY; y < endY; ++y)
+	{
+		// Starts at the guard word before the row
+		const auto* otherRow = other.row(y - offset.y) - 1;
+		if (anyBitsOverlap(row(y) + wordShift, otherRow, endWord - wordShift, bitShift))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+/**
+ * Copies an area of the mask, such as one frame of a sprite sheet.
+ */
+CollisionMask CollisionMask::subMask(const Rectangle<int>& rect) const
+{
+	if (!Rectangle{{0, 0}, mSize}.contains(rect) || rect.size.x < 0 || rect.size.y < 0)
+	{
+		throw std::runtime_error("CollisionMask area out of bounds: " + rectToString(rect));
+	}
+
+	CollisionMask mask{rect.size};
+	const auto wordShift = static_cast<std::size_t>(rect.position.x) / WordBits;
+	const auto bitShift = static_cast<std::size_t>(rect.position.x) % WordBits;
+	const auto tailBits = static_cast<std::size_t>(rect.size.x) % WordBits;
+
+	for (int y = 0; y < rect.size.y; ++y)
+	{
+		// Reading one word past the area can reach the guard word after the row
+		const auto* source = row(rect.position.y + y) + wordShift;
+		auto* destination = mask.row(y);
+		for (std::size_t i = 0; i < mask.mWordsPerRow; ++i)
+		{
+			destination[i] = bitShift == 0 ? source[i] : (source[i] >> bitShift) | (source[i + 1] << (WordBits - bitShift));
+		}
+		if (tailBits != 0)
+		{
+			destination[mask.mWordsPerRow - 1] &= (uint64_t{1} << tailBits) - 1;
+		}
+	}
+
+	return mask;
+}
+
+
+const uint64_t* CollisionMask::row(int y) const
+{
+	return mWords.data() + static_cast<std::size_t>(y) * mRowStride + 1;
+}
+
+
+uint64_t* CollisionMask::row(int y)
+{
+	return mWords.data() + static_cast<std::size_t>(y) * mRowStride + 1;
+}
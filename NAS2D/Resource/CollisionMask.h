@@ -0,0 +1,74 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include "AnimationSet.h"
+
+#include "../Math/Point.h"
+#include "../Math/Rectangle.h"
+#include "../Math/Vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace NAS2D
+{
+	class Image;
+	class ImagePixels;
+
+
+	/**
+	 * Bit mask of the solid pixels of an image, for pixel perfect hit testing.
+	 *
+	 * A pixel is solid if its alpha is above a threshold. Rows are packed 64
+	 * pixels to a word, so overlap tests between masks compare 64 pixels per
+	 * operation, or 128 with SSE2.
+	 *
+	 * \code{.cpp}
+	 * const auto masks = CollisionMask::fromFrames(animationSet.frames("walk"));
+	 * // Offset is the position of the second mask relative to the first
+	 * const auto isHit = masks[frameIndex].overlaps(bulletMask, bulletPosition - spritePosition);
+	 * \endcode
+	 */
+	class CollisionMask
+	{
+	public:
+		static constexpr uint8_t DefaultAlphaThreshold{0};
+
+		static std::vector<CollisionMask> fromFrames(const std::vector<AnimationSet::Frame>& frames, uint8_t alphaThreshold = DefaultAlphaThreshold);
+
+		explicit CollisionMask(Vector<int> size);
+		CollisionMask(const ImagePixels& pixels, const Rectangle<int>& rect, uint8_t alphaThreshold = DefaultAlphaThreshold);
+		explicit CollisionMask(const Image& image, uint8_t alphaThreshold = DefaultAlphaThreshold);
+		explicit CollisionMask(const AnimationSet::Frame& frame, uint8_t alphaThreshold = DefaultAlphaThreshold);
+
+		Vector<int> size() const;
+
+		bool contains(Point<int> point) const;
+		void set(Point<int> point, bool isSolid);
+
+		bool overlaps(const CollisionMask& other, Vector<int> offset) const;
+
+		CollisionMask subMask(const Rectangle<int>& rect) const;
+
+	private:
+		const uint64_t* row(int y) const;
+		uint64_t* row(int y);
+
+		Vector<int> mSize;
+		std::size_t mWordsPerRow;
+		// Each row has a zero guard word before and after it, so shifted reads past either end need no checks
+		std::size_t mRowStride;
+		std::vector<uint64_t> mWords;
+	};
+} // namespace
@@ -0,0 +1,137 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "CookedImage.h"
+
+#include "Image.h"
+#include "../Filesystem.h"
+#include "../Utility.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+
+using namespace NAS2D;
+
+
+namespace
+{
+	constexpr std::string_view Magic{"NAS2DIMG"};
+	constexpr uint32_t FormatVersion{1};
+
+	// Magic, version, width, height, and padding so pixel rows start 8 byte aligned
+	struct Header
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t width;
+		uint32_t height;
+		uint32_t reserved;
+	};
+
+	static_assert(sizeof(Header) == 24);
+	static_assert(sizeof(Color) == 4);
+}
+
+
+/**
+ * Packs pixels into the cooked image format.
+ *
+ * Cooked images are stored as 8 bit RGBA, in the layout uploaded to textures,
+ * so loading them needs no decoding or conversion. Values are stored in native
+ * byte order, as cooking is meant to be part of building a release for a platform.
+ *
+ * \param	size	Size of the image in pixels.
+ * \param	pixels	Tightly packed rows of pixels, from top to bottom.
+ */
+std::string NAS2D::cookImage(Vector<int> size, std::span<const Color> pixels)
+{
+	const auto unsignedSize = size.to<std::size_t>();
+	if (size.x <= 0 || size.y <= 0 || pixels.size() != unsignedSize.x * unsignedSize.y)
+	{
+		throw std::runtime_error("Cooked image size does not match pixel count: {" + std::to_string(size.x) + ", " + std::to_string(size.y) + "}");
+	}
+
+	Header header{};
+	std::memcpy(header.magic, Magic.data(), Magic.size());
+	header.version = FormatVersion;
+	header.width = static_cast<uint32_t>(size.x);
+	header.height = static_cast<uint32_t>(size.y);
+
+	std::string data(sizeof(header) + pixels.size_bytes(), '\0');
+	std::memcpy(data.data(), &header, sizeof(header));
+	std::memcpy(data.data() + sizeof(header), pixels.data(), pixels.size_bytes());
+	return data;
+}
+
+
+/**
+ * Finds the pixels in cooked image data, without copying them.
+ *
+ * \return	Size and pixels of the image, or an empty optional if the data is not a cooked image.
+ *
+ * \throw	std::runtime_error if the data is a cooked image, but corrupt or from another format version.
+ */
+std::optional<CookedImage> NAS2D::parseCookedImage(std::span<std::byte> data)
+{
+	if (data.size() < Magic.size() || std::memcmp(data.data(), Magic.data(), Magic.size()) != 0)
+	{
+		return {};
+	}
+
+	Header header;
+	if (data.size() < sizeof(header))
+	{
+		throw std::runtime_error("Cooked image header is truncated");
+	}
+	std::memcpy(&header, data.data(), sizeof(header));
+
+	if (header.version != FormatVersion)
+	{
+		throw std::runtime_error("Cooked image format version unsupported: " + std::to_string(header.version));
+	}
+
+	const auto pixelCount = std::size_t{header.width} * std::size_t{header.height};
+	const auto maxDimension = static_cast<uint32_t>(std::numeric_limits<int>::max());
+	if (header.width > maxDimension || header.height > maxDimension || data.size() - sizeof(header) != pixelCount * sizeof(Color))
+	{
+		throw std::runtime_error("Cooked image size does not match its data: {" + std::to_string(header.width) + ", " + std::to_string(header.height) + "}");
+	}
+
+	const auto size = Vector{static_cast<int>(header.width), static_cast<int>(header.height)};
+	return CookedImage{size, {reinterpret_cast<Color*>(data.data() + sizeof(header)), pixelCount}};
+}
+
+
+/**
+ * Converts an image file into a cooked image file.
+ *
+ * Meant to be run while packaging data for release. Images are recognized as
+ * cooked by their contents, so a cooked file can replace the original without
+ * renaming.
+ *
+ * \param	sourcePath		Path of the image to convert, relative to the Filesystem search path.
+ * \param	destinationPath	Path to write the cooked image to, relative to the Filesystem write path.
+ */
+void NAS2D::cookImageFile(const std::string& sourcePath, const std::string& destinationPath)
+{
+	const Image image{sourcePath};
+	const auto pixels = image.pixels();
+
+	const auto size = pixels.size();
+	std::vector<Color> tightPixels(size.to<std::size_t>().x * size.to<std::size_t>().y);
+	pixels.copyRect({{0, 0}, size}, tightPixels);
+
+	Utility<Filesystem>::get().writeFile(destinationPath, cookImage(size, tightPixels));
+}
@@ -0,0 +1,38 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include "../Renderer/Color.h"
+#include "../Math/Vector.h"
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+
+
+namespace NAS2D
+{
+	/**
+	 * Pixels of a cooked image, pointing into the file data they were parsed from.
+	 */
+	struct CookedImage
+	{
+		Vector<int> size;
+		std::span<Color> pixels;
+	};
+
+
+	std::string cookImage(Vector<int> size, std::span<const Color> pixels);
+	std::optional<CookedImage> parseCookedImage(std::span<std::byte> data);
+
+	void cookImageFile(const std::string& sourcePath, const std::string& destinationPath);
+}
@@ -0,0 +1,152 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "DistanceField.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+
+using namespace NAS2D;
+
+
+namespace
+{
+	// Stands in for infinity, without producing NaN when subtracted from itself
+	constexpr float Far{1e20f};
+
+
+	/**
+	 * One dimensional squared distance transform of a sampled function.
+	 *
+	 * Computes the lower envelope of parabolas rooted at each sample, as described in
+	 * "Distance Transforms of Sampled Functions" by Felzenszwalb and Huttenlocher.
+	 * Samples are spaced by stride, so rows and columns can be processed in place.
+	 */
+	void distanceTransform(float* values, std::size_t count, std::size_t stride, std::vector<float>& f, std::vector<std::size_t>& v, std::vector<float>& z)
+	{
+		for (std::size_t q = 0; q < count; ++q)
+		{
+			f[q] = values[q * stride];
+		}
+
+		const auto intersection = [&f](std::size_t q, std::size_t p) {
+			const auto qf = static_cast<float>(q);
+			const auto pf = static_cast<float>(p);
+			return ((f[q] + qf * qf) - (f[p] + pf * pf)) / (2 * qf - 2 * pf);
+		};
+
+		std::size_t k = 0;
+		v[0] = 0;
+		z[0] = -Far;
+		z[1] = Far;
+		for (std::size_t q = 1; q < count; ++q)
+		{
+			auto s = intersection(q, v[k]);
+			while (s <= z[k])
+			{
+				--k;
+				s = intersection(q, v[k]);
+			}
+			++k;
+			v[k] = q;
+			z[k] = s;
+			z[k + 1] = Far;
+		}
+
+		k = 0;
+		for (std::size_t q = 0; q < count; ++q)
+		{
+			while (z[k + 1] < static_cast<float>(q))
+			{
+				++k;
+			}
+			const auto offset = static_cast<float>(q) - static_cast<float>(v[k]);
+			values[q * stride] = offset * offset + f[v[k]];
+		}
+	}
+
+
+	/**
+	 * Squared distance from each pixel to the nearest pixel where isTarget is true.
+	 */
+	std::vector<float> squaredDistances(const std::vector<bool>& isTarget, std::size_t width, std::size_t height)
+	{
+		std::vector<float> distances(isTarget.size());
+		std::transform(isTarget.begin(), isTarget.end(), distances.begin(), [](bool target) { return target ? 0.0f : Far; });
+
+		const auto maxLength = std::max(width, height);
+		std::vector<float> f(maxLength);
+		std::vector<std::size_t> v(maxLength);
+		std::vector<float> z(maxLength + 1);
+
+		for (std::size_t x = 0; x < width; ++x)
+		{
+			distanceTransform(distances.data() + x, height, width, f, v, z);
+		}
+		for (std::size_t y = 0; y < height; ++y)
+		{
+			distanceTransform(distances.data() + y * width, width, 1, f, v, z);
+		}
+
+		return distances;
+	}
+}
+
+
+/**
+ * Converts a coverage image, such as a rasterized glyph, into a signed distance field.
+ *
+ * Each output value encodes the distance to the nearest shape edge, with 128
+ * on the edge, larger values inside the shape, and smaller values outside.
+ * Distances beyond the spread are clamped. Sampling the field with linear
+ * filtering and thresholding at the midpoint recovers a sharp edge at any scale.
+ *
+ * \param	coverage	Coverage values, in rows from top to bottom. Values of 128 or more are inside the shape.
+ * \param	size		Size of the coverage image.
+ * \param	spread		Distance in pixels covered by the range of output values.
+ *
+ * \return	Distance field, padded by spread on each side, so its size is size + 2 * spread.
+ */
+std::vector<uint8_t> NAS2D::distanceField(const std::vector<uint8_t>& coverage, Vector<int> size, int spread)
+{
+	const auto padding = static_cast<std::size_t>(spread);
+	const auto sourceSize = size.to<std::size_t>();
+	const auto width = sourceSize.x + 2 * padding;
+	const auto height = sourceSize.y + 2 * padding;
+
+	std::vector<bool> isInside(width * height, false);
+	for (std::size_t y = 0; y < sourceSize.y; ++y)
+	{
+		for (std::size_t x = 0; x < sourceSize.x; ++x)
+		{
+			isInside[(y + padding) * width + x + padding] = coverage[y * sourceSize.x + x] >= 128;
+		}
+	}
+
+	std::vector<bool> isOutside(isInside.size());
+	std::transform(isInside.begin(), isInside.end(), isOutside.begin(), [](bool inside) { return !inside; });
+
+	const auto distanceToInside = squaredDistances(isInside, width, height);
+	const auto distanceToOutside = squaredDistances(isOutside, width, height);
+
+	std::vector<uint8_t> field(isInside.size());
+	const auto scale = 1.0f / (2.0f * static_cast<float>(spread));
+	for (std::size_t i = 0; i < field.size(); ++i)
+	{
+		// Pixel centers are half a pixel from the edge between inside and outside pixels
+		const auto signedDistance = isInside[i] ? 0.5f - std::sqrt(distanceToOutside[i]) : std::sqrt(distanceToInside[i]) - 0.5f;
+		const auto value = std::clamp(0.5f - signedDistance * scale, 0.0f, 1.0f);
+		field[i] = static_cast<uint8_t>(std::lround(value * 255.0f));
+	}
+
+	return field;
+}
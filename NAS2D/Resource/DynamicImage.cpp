@@ -0,0 +1,128 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "DynamicImage.h"
+#include "../Renderer/TextureChange.h"
+
+#if defined(__XCODE_BUILD__)
+#include <GLEW/GLEW.h>
+#else
+#include <GL/glew.h>
+#endif
+
+#include <SDL2/SDL.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+
+using namespace NAS2D;
+
+
+namespace
+{
+	SDL_Surface& createTransparentSurface(Vector<int> size)
+	{
+		// New surfaces are zero filled
+		auto* surface = SDL_CreateRGBSurfaceWithFormat(0, size.x, size.y, 32, SDL_PIXELFORMAT_RGBA32);
+		if (!surface)
+		{
+			throw std::runtime_error("DynamicImage surface creation failed: " + std::string{SDL_GetError()});
+		}
+		return *surface;
+	}
+}
+
+
+/**
+ * \param	size	Size of the image in pixels.
+ */
+DynamicImage::DynamicImage(Vector<int> size) :
+	Image{createTransparentSurface(size)}
+{
+	// Initial pixels are only needed until the texture exists
+	setSurfaceRetention(SurfaceRetention::Release);
+}
+
+
+DynamicImage::~DynamicImage()
+{
+	if (mPixelBufferIds[0] != 0)
+	{
+		glDeleteBuffers(static_cast<GLsizei>(mPixelBufferIds.size()), mPixelBufferIds.data());
+	}
+}
+
+
+/**
+ * Replaces the pixels of an area of the image.
+ *
+ * Updates before the image is first drawn only change its pixels in memory.
+ *
+ * \param	rect	Area of the image to replace.
+ * \param	pixels	Tightly packed rows of RGBA pixels, covering the area.
+ */
+void DynamicImage::update(const Rectangle<int>& rect, const Color* pixels)
+{
+	if (!Rectangle{{0, 0}, size()}.contains(rect))
+	{
+		throw std::runtime_error("DynamicImage update area out of bounds: {" + std::to_string(rect.position.x) + ", " + std::to_string(rect.position.y) + ", " + std::to_string(rect.size.x) + ", " + std::to_string(rect.size.y) + "}");
+	}
+	if (rect.empty())
+	{
+		return;
+	}
+
+	// Before the first draw there is no texture yet, and the surface is uploaded with the update
+	if (!isUploaded())
+	{
+		writeSurface(rect, pixels);
+		return;
+	}
+
+	const auto textureId = this->textureId();
+	// Quads queued before the update must show the old pixels
+	beforeTextureChange(textureId);
+
+	if (mPixelBufferIds[0] == 0 && (GLEW_VERSION_2_1 || GLEW_ARB_pixel_buffer_object))
+	{
+		glGenBuffers(static_cast<GLsizei>(mPixelBufferIds.size()), mPixelBufferIds.data());
+	}
+
+	auto isStaged = false;
+	if (mPixelBufferIds[0] != 0)
+	{
+		const auto byteCount = rect.size.to<std::size_t>().x * rect.size.to<std::size_t>().y * sizeof(Color);
+		mBufferIndex = (mBufferIndex + 1) % mPixelBufferIds.size();
+
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, mPixelBufferIds[mBufferIndex]);
+		// Orphan the previous contents, so the driver doesn't wait for an earlier transfer to finish
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(byteCount), nullptr, GL_STREAM_DRAW);
+		if (auto* bufferPixels = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY))
+		{
+			std::memcpy(bufferPixels, pixels, byteCount);
+			isStaged = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE;
+		}
+		if (!isStaged)
+		{
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		}
+	}
+
+	// Staged pixels are read from offset 0 of the bound pixel buffer
+	glBindTexture(GL_TEXTURE_2D, textureId);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, rect.position.x, rect.position.y, rect.size.x, rect.size.y, GL_RGBA, GL_UNSIGNED_BYTE, isStaged ? nullptr : pixels);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	updateMipmaps();
+	invalidateSurface();
+}
@@ -0,0 +1,47 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include "Image.h"
+
+#include "../Renderer/Color.h"
+#include "../Math/Rectangle.h"
+#include "../Math/Vector.h"
+
+#include <array>
+#include <cstddef>
+
+
+namespace NAS2D
+{
+	/**
+	 * Image whose pixels are replaced often, such as a minimap or a fog of war mask.
+	 *
+	 * The texture is kept for the life of the image, and update() uploads only the
+	 * changed area. Updates are staged through two alternating pixel buffer objects
+	 * where available, so an update doesn't wait for the previous one to reach the
+	 * texture.
+	 *
+	 * Starts fully transparent. Reading pixels downloads them from the texture.
+	 */
+	class DynamicImage : public Image
+	{
+	public:
+		explicit DynamicImage(Vector<int> size);
+		~DynamicImage() override;
+
+		void update(const Rectangle<int>& rect, const Color* pixels);
+
+	private:
+		std::array<unsigned int, 2> mPixelBufferIds{};
+		std::size_t mBufferIndex{0};
+	};
+} // namespace
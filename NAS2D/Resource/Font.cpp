@@ -8,10 +8,15 @@
 // = Acknowledgment of your use of NAS2D is appreciated but is not required.
 // ==================================================================================
 #include "Font.h"
+#include "DistanceField.h"
+#include "GlyphAtlas.h"
+#include "GlyphCache.h"
 
 #include "../Filesystem.h"
+#include "../Hash.h"
 #include "../Utility.h"
-#include "../Math/MathUtils.h"
+#include "../Utf8.h"
+#include "../Renderer/Color.h"
 #include "../Math/PointInRectangleRange.h"
 
 #if defined(__XCODE_BUILD__)
@@ -24,80 +29,208 @@
 #include <SDL2/SDL_ttf.h>
 #endif
 
-#include <cmath>
+#include <SDL2/SDL.h>
+
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
-
-extern unsigned int generateTexture(SDL_Surface* surface);
+#if defined(SDL_TTF_VERSION_ATLEAST)
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+#define NAS2D_TTF_GLYPH32
+#endif
+#endif
 
 
 using namespace NAS2D;
 
 
-namespace
+/**
+ * State needed to rasterize glyphs of a TrueType or OpenType font on demand.
+ */
+struct Font::TrueTypeData
 {
-	struct ColorMasks
-	{
-		unsigned int red;
-		unsigned int green;
-		unsigned int blue;
-		unsigned int alpha;
-	};
+	// The font reads from this buffer, so it must outlive the TTF_Font
+	std::string fontBuffer;
+	unsigned int pointSize;
+	// Distance covered by distance field glyphs, or 0 for coverage glyphs
+	int distanceFieldSpread;
+	TTF_Font* font;
+
+	// Rasterized glyphs not yet written to the baked glyph cache
+	GlyphCacheKey cacheKey;
+	std::vector<GlyphBitmap> unsavedGlyphs{};
 
-	constexpr ColorMasks MasksLittleEndian{0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000};
-	constexpr ColorMasks MasksBigEndian{0xff000000, 0x00ff0000, 0x0000ff00, 0x000000ff};
-	constexpr ColorMasks MasksDefault = (SDL_BYTEORDER == SDL_LIL_ENDIAN) ? MasksLittleEndian : MasksBigEndian;
+	TrueTypeData(std::string buffer, unsigned int ptSize, GlyphType glyphType);
+	TrueTypeData(const TrueTypeData&) = delete;
+	TrueTypeData& operator=(const TrueTypeData&) = delete;
+	~TrueTypeData();
+};
 
-	const int ASCII_TABLE_COUNT = 256;
+
+namespace
+{
 	const int GLYPH_MATRIX_SIZE = 16;
-	const int BITS_32 = 32;
-
-	Font::FontInfo load(const std::string& path, unsigned int ptSize);
-	Font::FontInfo loadBitmap(const std::string& path);
-	unsigned int generateFontTexture(SDL_Surface* fontSurface, std::vector<Font::GlyphMetrics>& glyphMetricsList);
-	SDL_Surface* generateFontSurface(TTF_Font* font, Vector<int> characterSize);
-	Vector<int> maxCharacterDimensions(TTF_Font* font);
-	Vector<int> roundedCharacterDimensions(Vector<int> maxSize);
-	void fillInCharacterDimensions(TTF_Font* font, std::vector<Font::GlyphMetrics>& glyphMetricsList);
-	void fillInTextureCoordinates(std::vector<Font::GlyphMetrics>& glyphMetricsList);
+	// Glyphs rasterized when a TrueType font is loaded
+	constexpr std::string_view PreloadCharacters{" !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~"};
+	// Rasterizing fewer glyphs than this on a thread costs more than it saves
+	constexpr std::size_t MinGlyphsPerThread{16};
+	constexpr std::size_t MaxThreads{8};
+
+	std::atomic<uint64_t> lastFontId{0};
+
+	SDL_Surface* loadBitmapSurface(const std::string& path);
+	std::shared_ptr<GlyphAtlas> sharedGlyphAtlas();
+	TTF_Font* openFont(const std::string& fontBuffer, unsigned int ptSize);
+	std::vector<GlyphBitmap> rasterizeGlyphs(const std::string& fontBuffer, unsigned int ptSize, int distanceFieldSpread, const std::u32string& codepoints);
+	GlyphBitmap renderGlyphBitmap(TTF_Font* font, char32_t codepoint, int distanceFieldSpread);
+	bool glyphIsProvided(TTF_Font* font, char32_t codepoint);
+	Font::GlyphMetrics loadGlyphMetrics(TTF_Font* font, char32_t codepoint);
+	SDL_Surface* renderGlyph(TTF_Font* font, char32_t codepoint);
+	Rectangle<int> opaqueBounds(const SDL_Surface& surface, Rectangle<int> area);
+	std::vector<uint8_t> alphaValues(const SDL_Surface& surface, Rectangle<int> bounds);
+	std::vector<Color> colorValues(const SDL_Surface& surface, Rectangle<int> bounds);
+	std::vector<Color> whiteAlphaPixels(const std::vector<uint8_t>& alpha);
+	std::filesystem::path glyphCachePath(const GlyphCacheKey& key);
+	std::string readGlyphCacheFile(const std::filesystem::path& path);
+	void writeGlyphCacheFile(const std::filesystem::path& path, const std::string& data);
+}
+
+
+Font::TrueTypeData::TrueTypeData(std::string buffer, unsigned int ptSize, GlyphType glyphType) :
+	fontBuffer{std::move(buffer)},
+	pointSize{ptSize},
+	// Enough range for outlines and shadows, while keeping glyphs compact
+	distanceFieldSpread{(glyphType == GlyphType::DistanceField) ? std::max(2, static_cast<int>(ptSize) / 8) : 0},
+	font{openFont(fontBuffer, ptSize)},
+	cacheKey{xxHash64(fontBuffer), ptSize, glyphType == GlyphType::DistanceField}
+{
+}
+
+
+Font::TrueTypeData::~TrueTypeData()
+{
+	TTF_CloseFont(font);
 }
 
 
 /**
  * Instantiate a Font using a TrueType or OpenType font.
  *
+ * Printable ASCII glyphs are rasterized at load, spread over worker threads,
+ * and other glyphs when they are first used. Rasterized glyphs are baked
+ * into a cache in the user's preferences folder, which later loads of the
+ * same font file and point size read instead of rasterizing.
+ *
+ * Distance field glyphs are drawn sharply at any scale, so one size of font
+ * can serve all UI scales. Their point size sets the detail the glyphs keep,
+ * 32pt or more works well. Distance field fonts have their own glyph atlas.
+ *
  * \param	filePath	Path to a font file.
  * \param	ptSize		Point size of the font. Defaults to 12pt.
+ * \param	glyphType	Whether to store glyph coverage, or distance fields.
  */
-Font::Font(const std::string& filePath, unsigned int ptSize) :
-	mFontInfo{load(filePath, ptSize)}
+Font::Font(const std::string& filePath, unsigned int ptSize, GlyphType glyphType) :
+	mFontInfo{},
+	mTrueTypeData{},
+	mGlyphAtlas{(glyphType == GlyphType::DistanceField) ? std::make_shared<GlyphAtlas>() : sharedGlyphAtlas()},
+	mAtlasTextureIds{},
+	mGlyphMetrics{},
+	mId{++lastFontId}
 {
+	if (TTF_WasInit() == 0)
+	{
+		if (TTF_Init() != 0)
+		{
+			throw std::runtime_error("Font load function failed: " + std::string{TTF_GetError()});
+		}
+	}
+
+	auto fontBuffer = Utility<Filesystem>::get().readFile(filePath);
+	if (fontBuffer.empty())
+	{
+		throw std::runtime_error("Font file is empty: " + filePath);
+	}
+
+	mTrueTypeData = std::make_unique<TrueTypeData>(std::move(fontBuffer), ptSize, glyphType);
+
+	mFontInfo.glyphType = glyphType;
+	mFontInfo.pointSize = ptSize;
+	mFontInfo.height = TTF_FontHeight(mTrueTypeData->font);
+	mFontInfo.ascent = TTF_FontAscent(mTrueTypeData->font);
+
+	loadGlyphCache();
+	preload(PreloadCharacters);
+	// Only when the baked cache is missing or lacks preloaded glyphs, so normally just on the first run
+	saveGlyphCache();
 }
 
 
 /**
  * Instantiate a Font as a bitmap font.
  *
+ * Glyph cells are cropped to their non-transparent pixels and packed into the glyph atlas.
+ *
  * \param	filePath	Path to a font file.
  */
 Font::Font(const std::string& filePath) :
-	mFontInfo{loadBitmap(filePath)}
+	mFontInfo{},
+	mTrueTypeData{},
+	mGlyphAtlas{sharedGlyphAtlas()},
+	mAtlasTextureIds{},
+	mGlyphMetrics{},
+	mId{++lastFontId}
 {
-}
+	auto* fontSurface = loadBitmapSurface(filePath);
 
+	const auto glyphSize = Vector{fontSurface->w, fontSurface->h} / GLYPH_MATRIX_SIZE;
+	mFontInfo.pointSize = static_cast<unsigned int>(glyphSize.y);
+	mFontInfo.height = glyphSize.y;
+	mFontInfo.ascent = glyphSize.y;
+	mFontInfo.glyphSize = glyphSize;
 
-Font::~Font()
-{
-	glDeleteTextures(1, &mFontInfo.textureId);
+	for (const auto glyphPosition : PointInRectangleRange(Rectangle<int>{{0, 0}, {GLYPH_MATRIX_SIZE, GLYPH_MATRIX_SIZE}}))
+	{
+		const auto glyph = static_cast<char32_t>(glyphPosition.y * GLYPH_MATRIX_SIZE + glyphPosition.x);
+		auto& metrics = mGlyphMetrics[glyph];
+		metrics.maxX = glyphSize.x;
+		metrics.maxY = glyphSize.y;
+		metrics.advance = glyphSize.x;
+
+		const auto cell = Rectangle{glyphPosition.skewBy(glyphSize), glyphSize};
+		const auto bounds = opaqueBounds(*fontSurface, cell);
+		if (!bounds.empty())
+		{
+			const auto pixels = colorValues(*fontSurface, bounds);
+			const auto region = mGlyphAtlas->add(bounds.size, pixels.data());
+			mAtlasTextureIds.push_back(region.textureId);
+			metrics.textureId = region.textureId;
+			metrics.uvRect = region.uvRect;
+			metrics.drawBounds = bounds.translate(Point<int>{0, 0} - cell.position);
+		}
+	}
+
+	SDL_FreeSurface(fontSurface);
 }
 
 
-Vector<int> Font::glyphCellSize() const
+Font::~Font()
 {
-	return mFontInfo.glyphSize;
+	// The shared atlas outlives this font while other fonts use it, so give back its space
+	for (const auto textureId : mAtlasTextureIds)
+	{
+		mGlyphAtlas->release(textureId);
+	}
 }
 
 
@@ -110,20 +243,15 @@ Vector<int> Font::size(std::string_view string) const
 /**
  * Gets the width in pixels of a string rendered using the Font.
  *
- * \param	string		String to get the width of.
+ * \param	string		UTF-8 encoded string to get the width of.
  */
 int Font::width(std::string_view string) const
 {
-	if (string.empty()) { return 0; }
-
 	int width = 0;
-	auto& gml = mFontInfo.metrics;
-	if (gml.empty()) { return 0; }
-
-	for (auto character : string)
+	for (const auto codepoint : Utf8CodepointRange{string})
 	{
-		auto glyph = std::clamp<std::size_t>(static_cast<uint8_t>(character), 0, 255);
-		width += gml[glyph].advance + gml[glyph].minX;
+		const auto& metrics = glyphMetrics(codepoint);
+		width += metrics.advance + metrics.minX;
 	}
 
 	return width;
@@ -157,73 +285,198 @@ unsigned int Font::ptSize() const
 }
 
 
-const std::vector<Font::GlyphMetrics>& Font::metrics() const
+/**
+ * Identifies the font for caches keyed by font.
+ *
+ * Unlike its address, which a later font can reuse, the id of a font is
+ * never given to another font.
+ */
+uint64_t Font::id() const
 {
-	return mFontInfo.metrics;
+	return mId;
 }
 
 
-unsigned int Font::textureId() const
+Font::GlyphType Font::glyphType() const
 {
-	return mFontInfo.textureId;
+	return mFontInfo.glyphType;
 }
 
 
-namespace
+/**
+ * Gets the metrics and texture location of a glyph.
+ *
+ * The glyph is rasterized into the glyph atlas if this is its first use.
+ *
+ * \note	Requires an active OpenGL context the first time a glyph is used.
+ */
+const Font::GlyphMetrics& Font::glyphMetrics(char32_t codepoint) const
 {
-	/**
-	 * Loads a TrueType or OpenType font from a file.
-	 *
-	 * \param	path	Path to the TTF or OTF font file.
-	 * \param	ptSize	Point size to use when loading the font.
-	 */
-	Font::FontInfo load(const std::string& path, unsigned int ptSize)
+	const auto iterator = mGlyphMetrics.find(codepoint);
+	if (iterator != mGlyphMetrics.end())
 	{
-		if (TTF_WasInit() == 0)
-		{
-			if (TTF_Init() != 0)
-			{
-				throw std::runtime_error("Font load function failed: " + std::string{TTF_GetError()});
-			}
-		}
+		return iterator->second;
+	}
 
-		auto fontBuffer = Utility<Filesystem>::get().readFile(path);
-		if (fontBuffer.empty())
+	if (!mTrueTypeData)
+	{
+		return glyphMetrics('?');
+	}
+
+	return rasterizeGlyph(codepoint);
+}
+
+
+/**
+ * Rasterizes glyphs ahead of their first use.
+ *
+ * Glyphs are rendered in parallel. They are added to the baked glyph cache
+ * by the next saveGlyphCache(). Has no effect on bitmap fonts.
+ *
+ * \param	characters	UTF-8 encoded string of the characters to rasterize.
+ */
+void Font::preload(std::string_view characters)
+{
+	if (!mTrueTypeData) { return; }
+
+	std::u32string codepoints;
+	for (const auto codepoint : Utf8CodepointRange{characters})
+	{
+		const auto isNew = mGlyphMetrics.find(codepoint) == mGlyphMetrics.end() && codepoints.find(codepoint) == std::u32string::npos;
+		if (isNew && glyphIsProvided(mTrueTypeData->font, codepoint))
 		{
-			throw std::runtime_error("Font file is empty: " + path);
+			codepoints.push_back(codepoint);
 		}
+	}
 
-		auto* font = TTF_OpenFontRW(SDL_RWFromConstMem(fontBuffer.c_str(), static_cast<int>(fontBuffer.size())), 1, static_cast<int>(ptSize));
-		if (!font)
+	// All requested glyphs are already loaded, such as from the baked glyph cache
+	if (codepoints.empty()) { return; }
+
+	for (auto& glyph : rasterizeGlyphs(mTrueTypeData->fontBuffer, mTrueTypeData->pointSize, mTrueTypeData->distanceFieldSpread, codepoints))
+	{
+		addGlyph(glyph);
+		mTrueTypeData->unsavedGlyphs.push_back(std::move(glyph));
+	}
+}
+
+
+const Font::GlyphMetrics& Font::rasterizeGlyph(char32_t codepoint) const
+{
+	auto* font = mTrueTypeData->font;
+	if (!glyphIsProvided(font, codepoint) && codepoint != '?')
+	{
+		const auto fallback = glyphIsProvided(font, ReplacementCharacter) ? ReplacementCharacter : U'?';
+		return mGlyphMetrics[codepoint] = glyphMetrics(fallback);
+	}
+
+	auto glyph = renderGlyphBitmap(font, codepoint, mTrueTypeData->distanceFieldSpread);
+	const auto& metrics = addGlyph(glyph);
+	mTrueTypeData->unsavedGlyphs.push_back(std::move(glyph));
+	return metrics;
+}
+
+
+/**
+ * Packs a rasterized glyph into the glyph atlas.
+ */
+const Font::GlyphMetrics& Font::addGlyph(const GlyphBitmap& glyph) const
+{
+	auto metrics = glyph.metrics;
+	if (!metrics.drawBounds.empty())
+	{
+		const auto pixels = whiteAlphaPixels(glyph.alpha);
+		const auto region = mGlyphAtlas->add(metrics.drawBounds.size, pixels.data());
+		mAtlasTextureIds.push_back(region.textureId);
+		metrics.textureId = region.textureId;
+		metrics.uvRect = region.uvRect;
+	}
+
+	return mGlyphMetrics[glyph.codepoint] = metrics;
+}
+
+
+/**
+ * Adds glyphs baked by an earlier load of the same font, if there are any.
+ *
+ * A missing cache is not an error, and an unreadable one is only logged. The
+ * glyphs are rasterized instead.
+ */
+void Font::loadGlyphCache()
+{
+	try
+	{
+		const auto path = glyphCachePath(mTrueTypeData->cacheKey);
+		if (!std::filesystem::exists(path)) { return; }
+
+		// Glyph bitmaps are not kept once packed, the cache file already has them
+		for (const auto& glyph : deserializeGlyphCache(mTrueTypeData->cacheKey, readGlyphCacheFile(path)))
 		{
-			throw std::runtime_error("Font load function failed: " + std::string{TTF_GetError()});
+			addGlyph(glyph);
 		}
+	}
+	catch (const std::runtime_error& error)
+	{
+		SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Glyph cache not loaded: %s", error.what());
+	}
+}
+
+
+/**
+ * Adds newly rasterized glyphs to the baked glyph cache, then frees their bitmaps.
+ *
+ * Glyphs rasterized when the font is loaded are saved by the constructor.
+ * Glyphs from later preloads, or first drawn since, are saved only by
+ * calling this, such as after loading a level or before exiting. Nothing
+ * is saved when the font is destroyed.
+ *
+ * Glyphs already in the cache file are read back and kept, so bitmaps
+ * don't need to stay in memory between saves. Failure to write the cache
+ * is logged and otherwise ignored, as it only affects load times. Has no
+ * effect on bitmap fonts.
+ */
+void Font::saveGlyphCache() const
+{
+	if (!mTrueTypeData || mTrueTypeData->unsavedGlyphs.empty()) { return; }
 
-		Font::FontInfo fontInfo;
-		auto& glm = fontInfo.metrics;
-		fillInCharacterDimensions(font, glm);
-		const auto charBoundsSize = maxCharacterDimensions(font);
-		const auto roundedCharSize = roundedCharacterDimensions(charBoundsSize);
-		SDL_Surface* fontSurface = generateFontSurface(font, roundedCharSize);
+	auto& unsavedGlyphs = mTrueTypeData->unsavedGlyphs;
+	try
+	{
+		const auto& cacheKey = mTrueTypeData->cacheKey;
+		const auto path = glyphCachePath(cacheKey);
 
-		fontInfo.pointSize = ptSize;
-		fontInfo.height = TTF_FontHeight(font);
-		fontInfo.ascent = TTF_FontAscent(font);
-		fontInfo.glyphSize = roundedCharSize;
-		fontInfo.textureId = generateFontTexture(fontSurface, glm);
-		SDL_FreeSurface(fontSurface);
-		TTF_CloseFont(font);
+		auto glyphs = std::filesystem::exists(path) ? deserializeGlyphCache(cacheKey, readGlyphCacheFile(path)) : std::vector<GlyphBitmap>{};
+		for (auto& glyph : unsavedGlyphs)
+		{
+			// Another instance of the same font may have saved the glyph meanwhile
+			const auto isSaved = std::any_of(glyphs.begin(), glyphs.end(), [codepoint = glyph.codepoint](const auto& savedGlyph) { return savedGlyph.codepoint == codepoint; });
+			if (!isSaved)
+			{
+				glyphs.push_back(std::move(glyph));
+			}
+		}
 
-		return fontInfo;
+		writeGlyphCacheFile(path, serializeGlyphCache(cacheKey, glyphs));
+	}
+	catch (const std::runtime_error& error)
+	{
+		SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Glyph cache not saved: %s", error.what());
 	}
 
+	unsavedGlyphs.clear();
+	unsavedGlyphs.shrink_to_fit();
+}
 
+
+namespace
+{
 	/**
-	 * Internal function that loads a bitmap font from an file.
+	 * Internal function that loads a bitmap font image from an file.
 	 *
 	 * \param	path		Path to the image file.
+	 *
+	 * \return	Font image, converted to 32 bit RGBA.
 	 */
-	Font::FontInfo loadBitmap(const std::string& path)
+	SDL_Surface* loadBitmapSurface(const std::string& path)
 	{
 		auto fontBuffer = Utility<Filesystem>::get().readFile(path);
 		if (fontBuffer.empty())
@@ -231,7 +484,14 @@ namespace
 			throw std::runtime_error("Font file is empty: " + path);
 		}
 
-		SDL_Surface* fontSurface = IMG_Load_RW(SDL_RWFromConstMem(fontBuffer.c_str(), static_cast<int>(fontBuffer.size())), 1);
+		SDL_Surface* loadedSurface = IMG_Load_RW(SDL_RWFromConstMem(fontBuffer.c_str(), static_cast<int>(fontBuffer.size())), 1);
+		if (!loadedSurface)
+		{
+			throw std::runtime_error("Font loadBitmap function failed: " + std::string{SDL_GetError()});
+		}
+
+		SDL_Surface* fontSurface = SDL_ConvertSurfaceFormat(loadedSurface, SDL_PIXELFORMAT_RGBA32, 0);
+		SDL_FreeSurface(loadedSurface);
 		if (!fontSurface)
 		{
 			throw std::runtime_error("Font loadBitmap function failed: " + std::string{SDL_GetError()});
@@ -247,109 +507,261 @@ namespace
 			throw std::runtime_error("Unexpected font image size. Image dimensions " + vectorToString(fontSurfaceSize) + " must both be evenly divisble by " + std::to_string(GLYPH_MATRIX_SIZE));
 		}
 
-		Font::FontInfo fontInfo;
-		auto& glm = fontInfo.metrics;
-		glm.resize(ASCII_TABLE_COUNT);
-		for (auto& metrics : glm)
+		return fontSurface;
+	}
+
+
+	/**
+	 * Glyph atlas shared by all fonts, so text in different fonts can be drawn in one batch.
+	 *
+	 * The atlas is released when the last font using it is destroyed.
+	 */
+	std::shared_ptr<GlyphAtlas> sharedGlyphAtlas()
+	{
+		static std::weak_ptr<GlyphAtlas> sharedAtlas;
+
+		auto glyphAtlas = sharedAtlas.lock();
+		if (!glyphAtlas)
 		{
-			metrics.minX = 0;
-			metrics.minY = 0;
-			metrics.maxX = glyphSize.x;
-			metrics.maxY = glyphSize.y;
-			metrics.advance = glyphSize.x;
+			glyphAtlas = std::make_shared<GlyphAtlas>();
+			sharedAtlas = glyphAtlas;
 		}
+		return glyphAtlas;
+	}
 
-		fontInfo.pointSize = static_cast<unsigned int>(glyphSize.y);
-		fontInfo.height = glyphSize.y;
-		fontInfo.ascent = glyphSize.y;
-		fontInfo.glyphSize = glyphSize;
-		fontInfo.textureId = generateFontTexture(fontSurface, glm);
-		SDL_FreeSurface(fontSurface);
 
-		return fontInfo;
+	TTF_Font* openFont(const std::string& fontBuffer, unsigned int ptSize)
+	{
+		auto* font = TTF_OpenFontRW(SDL_RWFromConstMem(fontBuffer.c_str(), static_cast<int>(fontBuffer.size())), 1, static_cast<int>(ptSize));
+		if (!font)
+		{
+			throw std::runtime_error("Font load function failed: " + std::string{TTF_GetError()});
+		}
+		return font;
 	}
 
 
 	/**
-	 * Generates a glyph map of all ASCII standard characters from 0 - 255.
+	 * Rasterizes glyphs on worker threads.
 	 *
-	 * Internal function used to generate a glyph texture map from an TTF_Font struct.
+	 * SDL_ttf fonts can not be shared between threads, so each worker renders
+	 * with its own TTF_Font. Fonts are opened and closed on the calling thread,
+	 * as FreeType does not allow concurrent creation of faces.
 	 */
-	unsigned int generateFontTexture(SDL_Surface* fontSurface, std::vector<Font::GlyphMetrics>& glyphMetricsList)
+	std::vector<GlyphBitmap> rasterizeGlyphs(const std::string& fontBuffer, unsigned int ptSize, int distanceFieldSpread, const std::u32string& codepoints)
 	{
-		fillInTextureCoordinates(glyphMetricsList);
-		return generateTexture(fontSurface);
+		if (codepoints.empty()) { return {}; }
+
+		const auto threadLimit = std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, MaxThreads);
+		const auto threadCount = std::clamp<std::size_t>(codepoints.size() / MinGlyphsPerThread, 1, threadLimit);
+
+		std::vector<std::unique_ptr<TTF_Font, decltype(&TTF_CloseFont)>> fonts;
+		for (std::size_t i = 0; i < threadCount; ++i)
+		{
+			fonts.emplace_back(openFont(fontBuffer, ptSize), &TTF_CloseFont);
+		}
+
+		std::vector<std::future<std::vector<GlyphBitmap>>> results;
+		for (std::size_t i = 0; i < threadCount; ++i)
+		{
+			results.push_back(std::async(std::launch::async, [&codepoints, font = fonts[i].get(), i, threadCount, distanceFieldSpread]() {
+				std::vector<GlyphBitmap> glyphs;
+				for (auto index = i; index < codepoints.size(); index += threadCount)
+				{
+					glyphs.push_back(renderGlyphBitmap(font, codepoints[index], distanceFieldSpread));
+				}
+				return glyphs;
+			}));
+		}
+
+		std::vector<GlyphBitmap> glyphs;
+		for (auto& result : results)
+		{
+			auto threadGlyphs = result.get();
+			std::move(threadGlyphs.begin(), threadGlyphs.end(), std::back_inserter(glyphs));
+		}
+
+		return glyphs;
 	}
 
 
-	SDL_Surface* generateFontSurface(TTF_Font* font, Vector<int> characterSize)
+	/**
+	 * Rasterizes a glyph, cropped to its covered pixels.
+	 *
+	 * Distance field glyphs are converted from the coverage, and extend past
+	 * the covered pixels by the spread.
+	 */
+	GlyphBitmap renderGlyphBitmap(TTF_Font* font, char32_t codepoint, int distanceFieldSpread)
 	{
-		const auto matrixSize = characterSize * GLYPH_MATRIX_SIZE;
-		SDL_Surface* fontSurface = SDL_CreateRGBSurface(SDL_SWSURFACE, matrixSize.x, matrixSize.y, BITS_32, MasksDefault.red, MasksDefault.green, MasksDefault.blue, MasksDefault.alpha);
+		GlyphBitmap glyph{codepoint, loadGlyphMetrics(font, codepoint), {}};
 
-		SDL_Color white = {255, 255, 255, 255};
-		for (const auto glyphPosition : PointInRectangleRange(Rectangle<std::size_t>{{0, 0}, {GLYPH_MATRIX_SIZE, GLYPH_MATRIX_SIZE}}))
+		// A glyph surface can fail to be created for glyphs of size 0
+		auto* surface = renderGlyph(font, codepoint);
+		if (surface)
 		{
-			const std::size_t glyph = glyphPosition.y * GLYPH_MATRIX_SIZE + glyphPosition.x;
+			// Only the covered part of the glyph is stored, rather than its full line height cell
+			const auto bounds = opaqueBounds(*surface, {{0, 0}, {surface->w, surface->h}});
+			if (!bounds.empty())
+			{
+				glyph.alpha = alphaValues(*surface, bounds);
+				glyph.metrics.drawBounds = bounds.translate({std::min(glyph.metrics.minX, 0), 0});
+
+				if (distanceFieldSpread > 0)
+				{
+					glyph.alpha = distanceField(glyph.alpha, bounds.size, distanceFieldSpread);
+					glyph.metrics.drawBounds = glyph.metrics.drawBounds.inset(-distanceFieldSpread);
+				}
+			}
+			SDL_FreeSurface(surface);
+		}
+
+		return glyph;
+	}
+
+
+#if defined(NAS2D_TTF_GLYPH32)
+	bool glyphIsProvided(TTF_Font* font, char32_t codepoint)
+	{
+		return TTF_GlyphIsProvided32(font, codepoint) != 0;
+	}
+
+
+	Font::GlyphMetrics loadGlyphMetrics(TTF_Font* font, char32_t codepoint)
+	{
+		Font::GlyphMetrics metrics;
+		TTF_GlyphMetrics32(font, codepoint, &metrics.minX, &metrics.maxX, &metrics.minY, &metrics.maxY, &metrics.advance);
+		return metrics;
+	}
+
 
-			SDL_Surface* characterSurface = TTF_RenderGlyph_Blended(font, static_cast<uint16_t>(glyph), white);
-			// A character surface can fail to be created for glyphs of size 0
-			if (characterSurface)
+	SDL_Surface* renderGlyph(TTF_Font* font, char32_t codepoint)
+	{
+		return TTF_RenderGlyph32_Blended(font, codepoint, SDL_Color{255, 255, 255, 255});
+	}
+#else
+	// Older SDL_ttf versions only support the Basic Multilingual Plane
+	bool glyphIsProvided(TTF_Font* font, char32_t codepoint)
+	{
+		return codepoint <= 0xFFFF && TTF_GlyphIsProvided(font, static_cast<Uint16>(codepoint)) != 0;
+	}
+
+
+	Font::GlyphMetrics loadGlyphMetrics(TTF_Font* font, char32_t codepoint)
+	{
+		Font::GlyphMetrics metrics;
+		TTF_GlyphMetrics(font, static_cast<Uint16>(codepoint), &metrics.minX, &metrics.maxX, &metrics.minY, &metrics.maxY, &metrics.advance);
+		return metrics;
+	}
+
+
+	SDL_Surface* renderGlyph(TTF_Font* font, char32_t codepoint)
+	{
+		return TTF_RenderGlyph_Blended(font, static_cast<Uint16>(codepoint), SDL_Color{255, 255, 255, 255});
+	}
+#endif
+
+
+	Color colorAt(const SDL_Surface& surface, int x, int y)
+	{
+		const auto* row = static_cast<const Uint8*>(surface.pixels) + static_cast<std::size_t>(y) * static_cast<std::size_t>(surface.pitch);
+		Color color;
+		SDL_GetRGBA(reinterpret_cast<const Uint32*>(row)[x], surface.format, &color.red, &color.green, &color.blue, &color.alpha);
+		return color;
+	}
+
+
+	/**
+	 * Finds the smallest rectangle within an area containing all non-transparent pixels.
+	 *
+	 * \note	Expects a 32 bit surface.
+	 */
+	Rectangle<int> opaqueBounds(const SDL_Surface& surface, Rectangle<int> area)
+	{
+		auto startPoint = area.endPoint();
+		auto endPoint = area.startPoint();
+		for (const auto point : PointInRectangleRange(area))
+		{
+			if (colorAt(surface, point.x, point.y).alpha != 0)
 			{
-				SDL_SetSurfaceBlendMode(characterSurface, SDL_BLENDMODE_NONE);
-				const auto pixelPosition = glyphPosition.to<int>().skewBy(characterSize);
-				SDL_Rect rect = {pixelPosition.x, pixelPosition.y, 0, 0};
-				SDL_BlitSurface(characterSurface, nullptr, fontSurface, &rect);
-				SDL_FreeSurface(characterSurface);
+				startPoint = {std::min(startPoint.x, point.x), std::min(startPoint.y, point.y)};
+				endPoint = {std::max(endPoint.x, point.x + 1), std::max(endPoint.y, point.y + 1)};
 			}
 		}
 
-		return fontSurface;
+		if (startPoint.x >= endPoint.x) { return {}; }
+		return Rectangle<int>::Create(startPoint, endPoint);
 	}
 
 
-	Vector<int> maxCharacterDimensions(TTF_Font* font)
+	/**
+	 * Copies the coverage of part of a glyph surface, in rows from top to bottom.
+	 */
+	std::vector<uint8_t> alphaValues(const SDL_Surface& surface, Rectangle<int> bounds)
 	{
-		Vector<int> size{0, 0};
+		std::vector<uint8_t> alpha;
+		alpha.reserve(static_cast<std::size_t>(bounds.size.x) * static_cast<std::size_t>(bounds.size.y));
+		for (const auto point : PointInRectangleRange(bounds))
+		{
+			alpha.push_back(colorAt(surface, point.x, point.y).alpha);
+		}
+		return alpha;
+	}
+
 
-		for (int i = 0; i < 256; ++i)
+	std::vector<Color> colorValues(const SDL_Surface& surface, Rectangle<int> bounds)
+	{
+		std::vector<Color> pixels;
+		pixels.reserve(static_cast<std::size_t>(bounds.size.x) * static_cast<std::size_t>(bounds.size.y));
+		for (const auto point : PointInRectangleRange(bounds))
+		{
+			pixels.push_back(colorAt(surface, point.x, point.y));
+		}
+		return pixels;
+	}
+
+
+	/**
+	 * Expands glyph coverage into white pixels, for tinting by the draw color.
+	 */
+	std::vector<Color> whiteAlphaPixels(const std::vector<uint8_t>& alpha)
+	{
+		std::vector<Color> pixels;
+		pixels.reserve(alpha.size());
+		for (const auto value : alpha)
 		{
-			Vector<int> sizeChar;
-			char text[2] = {static_cast<char>(i), 0};
-			TTF_SizeText(font, text, &sizeChar.x, &sizeChar.y);
-			size = {std::max({size.x, sizeChar.x}), std::max({size.y, sizeChar.y})};
+			pixels.push_back({255, 255, 255, value});
 		}
-		return size;
+		return pixels;
 	}
 
 
-	Vector<int> roundedCharacterDimensions(Vector<int> maxSize)
+	// In the pref path itself, which is not necessarily the write path or mounted for reading
+	std::filesystem::path glyphCachePath(const GlyphCacheKey& key)
 	{
-		const auto maxSizeUint32 = maxSize.to<uint32_t>();
-		const auto roundedUpSize = Vector{roundUpPowerOf2(maxSizeUint32.x), roundUpPowerOf2(maxSizeUint32.y)};
-		return roundedUpSize.to<int>();
+		return Utility<Filesystem>::get().prefPath() / "FontCache" / key.fileName();
 	}
 
 
-	void fillInCharacterDimensions(TTF_Font* font, std::vector<Font::GlyphMetrics>& glyphMetricsList)
+	std::string readGlyphCacheFile(const std::filesystem::path& path)
 	{
-		// Build table of character sizes
-		for (Uint16 i = 0; i < ASCII_TABLE_COUNT; i++)
+		std::ifstream file{path, std::ios::in | std::ios::binary};
+		std::string data{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+		if (!file && !file.eof())
 		{
-			auto& metrics = glyphMetricsList.emplace_back();
-			TTF_GlyphMetrics(font, i, &metrics.minX, &metrics.maxX, &metrics.minY, &metrics.maxY, &metrics.advance);
+			throw std::runtime_error("Error reading glyph cache: " + path.string());
 		}
+		return data;
 	}
 
 
-	void fillInTextureCoordinates(std::vector<Font::GlyphMetrics>& glyphMetricsList)
+	void writeGlyphCacheFile(const std::filesystem::path& path, const std::string& data)
 	{
-		const auto uvSize = Vector<float>{1, 1} / 16.0f;
-		for (const auto glyphPosition : PointInRectangleRange(Rectangle<std::size_t>{{0, 0}, {GLYPH_MATRIX_SIZE, GLYPH_MATRIX_SIZE}}))
+		std::filesystem::create_directories(path.parent_path());
+		std::ofstream file{path, std::ios::out | std::ios::binary | std::ios::trunc};
+		file << data;
+		if (!file)
 		{
-			const std::size_t glyph = glyphPosition.y * GLYPH_MATRIX_SIZE + glyphPosition.x;
-			const auto uvStart = glyphPosition.to<float>().skewBy(uvSize);
-			glyphMetricsList[glyph].uvRect = Rectangle{uvStart, uvSize};
+			throw std::runtime_error("Error writing glyph cache: " + path.string());
 		}
 	}
 }
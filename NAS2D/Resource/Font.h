@@ -12,32 +12,53 @@
 #include "../Math/Vector.h"
 #include "../Math/Rectangle.h"
 
+#include <cstdint>
+#include <memory>
 #include <string>
-#include <vector>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 
 namespace NAS2D
 {
+	class GlyphAtlas;
+	struct GlyphBitmap;
+
+
 	/**
 	 * Font resource.
 	 *
 	 * The Font class can be used to render TrueType, OpenType and Bitmap fonts. Two
 	 * contructors are provided for these types.
 	 *
-	 * TrueType and OpenType fonts generate their own glyph map internally. Only
-	 * the ASCII values 0 - 255 are used. Unicode/UTF is not supported.
+	 * TrueType and OpenType fonts rasterize glyphs the first time they are used,
+	 * and pack them into a glyph atlas shared by all fonts. Text is expected to
+	 * be UTF-8 encoded. Codepoints not provided by the font are drawn as the
+	 * replacement character.
+	 *
+	 * Rasterized glyphs are baked into a glyph cache file in the pref path, and
+	 * loaded from it by later loads of the same font. See saveGlyphCache().
 	 *
 	 * Bitmap fonts are expected to be in a 16x16 glyph matrix with the top left
 	 * glyph cell equating to ASCII value '0'. Glyph values increase from left to
-	 * right up to ASCII value 255.
+	 * right up to ASCII value 255. Codepoints above 255 are drawn as '?'.
 	 */
 	class Font
 	{
 	public:
+		enum class GlyphType
+		{
+			Coverage,
+			DistanceField,
+		};
+
 		struct GlyphMetrics
 		{
+			unsigned int textureId{0u};
 			Rectangle<float> uvRect{};
+			// Area covered by the glyph image, relative to the pen position at the top of the line
+			Rectangle<int> drawBounds{};
 			int minX{0};
 			int minY{0};
 			int maxX{0};
@@ -51,35 +72,45 @@ namespace NAS2D
 		 */
 		struct FontInfo
 		{
-			unsigned int textureId{0u};
+			GlyphType glyphType{GlyphType::Coverage};
 			unsigned int pointSize{0u};
 			int height{0};
 			int ascent{0};
 			Vector<int> glyphSize{};
-			std::vector<GlyphMetrics> metrics{};
 		};
 
 
-		Font(const std::string& filePath, unsigned int ptSize);
+		Font(const std::string& filePath, unsigned int ptSize, GlyphType glyphType = GlyphType::Coverage);
 		explicit Font(const std::string& filePath);
 		Font(const Font& font) = delete;
 		Font& operator=(const Font& font) = delete;
 		~Font();
 
-		Vector<int> glyphCellSize() const;
 		Vector<int> size(std::string_view string) const;
 		int width(std::string_view string) const;
 		int height() const;
 		int ascent() const;
 		unsigned int ptSize() const;
-		const std::vector<GlyphMetrics>& metrics() const;
+		uint64_t id() const;
+		GlyphType glyphType() const;
+		const GlyphMetrics& glyphMetrics(char32_t codepoint) const;
 
-		// Temporary method, that will be removed in a future refactor
-		// Intended only to be used by RendererOpenGL
-		// As it is so specific, it should not be part of the Font class, nor FontInfo
-		unsigned int textureId() const;
+		void preload(std::string_view characters);
+		void saveGlyphCache() const;
 
 	private:
+		struct TrueTypeData;
+
+		const GlyphMetrics& rasterizeGlyph(char32_t codepoint) const;
+		const GlyphMetrics& addGlyph(const GlyphBitmap& glyph) const;
+		void loadGlyphCache();
+
 		FontInfo mFontInfo;
+		std::unique_ptr<TrueTypeData> mTrueTypeData;
+		std::shared_ptr<GlyphAtlas> mGlyphAtlas;
+		// One entry per glyph packed into the atlas, released when the font is destroyed
+		mutable std::vector<unsigned int> mAtlasTextureIds;
+		mutable std::unordered_map<char32_t, GlyphMetrics> mGlyphMetrics;
+		uint64_t mId;
 	};
 } // namespace
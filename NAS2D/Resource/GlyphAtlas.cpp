@@ -0,0 +1,126 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "GlyphAtlas.h"
+
+#include "../Math/MathUtils.h"
+#include "../Renderer/TextureChange.h"
+
+#if defined(__XCODE_BUILD__)
+#include <GLEW/GLEW.h>
+#else
+#include <GL/glew.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+
+
+using namespace NAS2D;
+
+
+namespace
+{
+	// Transparent gap between glyphs, so linear filtering doesn't bleed neighbouring glyphs
+	constexpr int GlyphPadding{1};
+}
+
+
+/**
+ * \param	pageSize	Size of each texture page. Glyphs larger than a page get a page of their own.
+ */
+GlyphAtlas::GlyphAtlas(Vector<int> pageSize) :
+	mPageSize{pageSize}
+{
+}
+
+
+GlyphAtlas::~GlyphAtlas()
+{
+	for (auto& page : mPages)
+	{
+		beforeTextureChange(page.textureId);
+		glDeleteTextures(1, &page.textureId);
+	}
+}
+
+
+/**
+ * Copies a glyph image into the atlas.
+ *
+ * \param	size	Size of the glyph image in pixels.
+ * \param	pixels	Glyph image, tightly packed rows of RGBA pixels.
+ *
+ * \return	Texture and texture coordinates of the packed glyph.
+ */
+GlyphAtlas::Region GlyphAtlas::add(Vector<int> size, const Color* pixels)
+{
+	auto position = mPages.empty() ? std::nullopt : mPages.back().packer.add(size);
+	if (!position)
+	{
+		position = addPage(size).packer.add(size);
+	}
+
+	auto& page = mPages.back();
+	++page.regionCount;
+	glBindTexture(GL_TEXTURE_2D, page.textureId);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, position->x, position->y, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+
+	const auto pageSize = page.packer.size().to<float>();
+	const auto uvRect = Rectangle<float>{position->to<float>(), size.to<float>()}.skewInverseBy(pageSize);
+	return {page.textureId, uvRect};
+}
+
+
+/**
+ * Releases a glyph added to the atlas, freeing its page when no other glyphs use it.
+ *
+ * \param	textureId	Texture of the Region returned when the glyph was added.
+ */
+void GlyphAtlas::release(unsigned int textureId)
+{
+	const auto iterator = std::find_if(mPages.begin(), mPages.end(), [textureId](const auto& page) { return page.textureId == textureId; });
+	if (iterator == mPages.end() || --iterator->regionCount > 0) { return; }
+
+	// Text drawn with the font being unloaded may still be queued
+	beforeTextureChange(iterator->textureId);
+	glDeleteTextures(1, &iterator->textureId);
+	mPages.erase(iterator);
+}
+
+
+std::size_t GlyphAtlas::pageCount() const
+{
+	return mPages.size();
+}
+
+
+GlyphAtlas::Page& GlyphAtlas::addPage(Vector<int> minimumSize)
+{
+	const auto paddedSize = (minimumSize + Vector{GlyphPadding, GlyphPadding}).to<uint32_t>();
+	const auto pageSize = Vector{
+		std::max(mPageSize.x, static_cast<int>(roundUpPowerOf2(paddedSize.x))),
+		std::max(mPageSize.y, static_cast<int>(roundUpPowerOf2(paddedSize.y))),
+	};
+
+	// Pages start fully transparent, which also fills the padding between glyphs
+	const std::vector<Color> clearPixels(static_cast<std::size_t>(pageSize.x) * static_cast<std::size_t>(pageSize.y), Color{0, 0, 0, 0});
+
+	unsigned int textureId;
+	glGenTextures(1, &textureId);
+	glBindTexture(GL_TEXTURE_2D, textureId);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, pageSize.x, pageSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, clearPixels.data());
+
+	return mPages.emplace_back(Page{textureId, RectanglePacker{pageSize, GlyphPadding}});
+}
@@ -0,0 +1,64 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include "../Renderer/Color.h"
+#include "../Math/Rectangle.h"
+#include "../Math/RectanglePacker.h"
+
+#include <cstddef>
+#include <vector>
+
+
+namespace NAS2D
+{
+	/**
+	 * Texture pages that glyph images are packed into as they are needed.
+	 *
+	 * Glyphs are packed tightly into the current page. A new page is started
+	 * when the current one is full. A page is freed once all glyphs packed
+	 * into it have been released.
+	 */
+	class GlyphAtlas
+	{
+	public:
+		struct Region
+		{
+			unsigned int textureId;
+			Rectangle<float> uvRect;
+		};
+
+		static constexpr Vector<int> DefaultPageSize{1024, 1024};
+
+		explicit GlyphAtlas(Vector<int> pageSize = DefaultPageSize);
+		GlyphAtlas(const GlyphAtlas&) = delete;
+		GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+		~GlyphAtlas();
+
+		Region add(Vector<int> size, const Color* pixels);
+		void release(unsigned int textureId);
+
+		std::size_t pageCount() const;
+
+	private:
+		struct Page
+		{
+			unsigned int textureId;
+			RectanglePacker packer;
+			std::size_t regionCount{0};
+		};
+
+		Page& addPage(Vector<int> minimumSize);
+
+		Vector<int> mPageSize;
+		std::vector<Page> mPages{};
+	};
+} // namespace
@@ -0,0 +1,167 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "GlyphCache.h"
+
+#include <cstddef>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <type_traits>
+
+
+using namespace NAS2D;
+
+
+namespace
+{
+	constexpr std::string_view Magic{"NAS2DGLY"};
+	constexpr uint32_t FormatVersion{2};
+
+
+	template <typename Value>
+	void write(std::string& data, Value value)
+	{
+		static_assert(std::is_trivially_copyable_v<Value>);
+		data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+
+	/**
+	 * Sequential reads from a byte buffer, which fail once the buffer is exhausted.
+	 */
+	class Reader
+	{
+	public:
+		explicit Reader(std::string_view data) :
+			mData{data}
+		{}
+
+		template <typename Value>
+		bool read(Value& value)
+		{
+			static_assert(std::is_trivially_copyable_v<Value>);
+			if (mData.size() < sizeof(value)) { return false; }
+			std::memcpy(&value, mData.data(), sizeof(value));
+			mData.remove_prefix(sizeof(value));
+			return true;
+		}
+
+		bool read(std::vector<uint8_t>& bytes, std::size_t count)
+		{
+			if (mData.size() < count) { return false; }
+			bytes.assign(mData.begin(), mData.begin() + static_cast<std::ptrdiff_t>(count));
+			mData.remove_prefix(count);
+			return true;
+		}
+
+		bool atEnd() const
+		{
+			return mData.empty();
+		}
+
+	private:
+		std::string_view mData;
+	};
+
+
+	bool read(Reader& reader, Font::GlyphMetrics& metrics)
+	{
+		auto& bounds = metrics.drawBounds;
+		return reader.read(metrics.minX) && reader.read(metrics.minY) &&
+			reader.read(metrics.maxX) && reader.read(metrics.maxY) && reader.read(metrics.advance) &&
+			reader.read(bounds.position.x) && reader.read(bounds.position.y) &&
+			reader.read(bounds.size.x) && reader.read(bounds.size.y) &&
+			bounds.size.x >= 0 && bounds.size.y >= 0;
+	}
+}
+
+
+/**
+ * Name of the cache file, unique to the font contents and point size.
+ */
+std::string GlyphCacheKey::fileName() const
+{
+	std::ostringstream stream;
+	stream << std::hex << std::setfill('0') << std::setw(16) << fontHash << std::dec << "-" << pointSize << (distanceField ? "-sdf" : "") << ".glyphs";
+	return stream.str();
+}
+
+
+/**
+ * Packs rasterized glyphs into a binary blob, for storage on disk.
+ *
+ * Values are stored in native byte order, as the cache is only meant to be
+ * read back on the machine that wrote it.
+ */
+std::string NAS2D::serializeGlyphCache(const GlyphCacheKey& key, const std::vector<GlyphBitmap>& glyphs)
+{
+	std::string data{Magic};
+	write(data, FormatVersion);
+	write(data, key.fontHash);
+	write(data, uint32_t{key.pointSize});
+	write(data, uint8_t{key.distanceField});
+	write(data, static_cast<uint32_t>(glyphs.size()));
+
+	for (const auto& glyph : glyphs)
+	{
+		const auto& metrics = glyph.metrics;
+		const auto& bounds = metrics.drawBounds;
+		write(data, uint32_t{glyph.codepoint});
+		write(data, metrics.minX);
+		write(data, metrics.minY);
+		write(data, metrics.maxX);
+		write(data, metrics.maxY);
+		write(data, metrics.advance);
+		write(data, bounds.position.x);
+		write(data, bounds.position.y);
+		write(data, bounds.size.x);
+		write(data, bounds.size.y);
+		data.append(glyph.alpha.begin(), glyph.alpha.end());
+	}
+
+	return data;
+}
+
+
+/**
+ * Reads back glyphs stored by serializeGlyphCache.
+ *
+ * \return	Stored glyphs, or an empty list if the data is corrupt, from an
+ *			older format, or was baked from a different font or point size.
+ */
+std::vector<GlyphBitmap> NAS2D::deserializeGlyphCache(const GlyphCacheKey& key, std::string_view data)
+{
+	if (data.substr(0, Magic.size()) != Magic) { return {}; }
+	Reader reader{data.substr(Magic.size())};
+
+	uint32_t version;
+	uint64_t fontHash;
+	uint32_t pointSize;
+	uint8_t distanceField;
+	uint32_t count;
+	if (!reader.read(version) || !reader.read(fontHash) || !reader.read(pointSize) || !reader.read(distanceField) || !reader.read(count)) { return {}; }
+	if (version != FormatVersion || fontHash != key.fontHash || pointSize != key.pointSize || (distanceField != 0) != key.distanceField) { return {}; }
+
+	std::vector<GlyphBitmap> glyphs;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		auto& glyph = glyphs.emplace_back();
+		uint32_t codepoint;
+		if (!reader.read(codepoint) || !read(reader, glyph.metrics)) { return {}; }
+
+		const auto size = glyph.metrics.drawBounds.size.to<std::size_t>();
+		if (!reader.read(glyph.alpha, size.x * size.y)) { return {}; }
+		glyph.codepoint = char32_t{codepoint};
+	}
+
+	if (!reader.atEnd()) { return {}; }
+	return glyphs;
+}
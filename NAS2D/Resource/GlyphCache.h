@@ -0,0 +1,51 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include "Font.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace NAS2D
+{
+	/**
+	 * A rasterized glyph, before it is packed into a glyph atlas.
+	 *
+	 * The alpha values cover metrics.drawBounds, in rows from top to bottom.
+	 */
+	struct GlyphBitmap
+	{
+		char32_t codepoint;
+		Font::GlyphMetrics metrics;
+		std::vector<uint8_t> alpha;
+	};
+
+
+	/**
+	 * Identifies the font a glyph cache was baked from.
+	 */
+	struct GlyphCacheKey
+	{
+		uint64_t fontHash;
+		unsigned int pointSize;
+		bool distanceField{false};
+
+		std::string fileName() const;
+	};
+
+
+	std::string serializeGlyphCache(const GlyphCacheKey& key, const std::vector<GlyphBitmap>& glyphs);
+	std::vector<GlyphBitmap> deserializeGlyphCache(const GlyphCacheKey& key, std::string_view data);
+}
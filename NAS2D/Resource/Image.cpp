@@ -9,8 +9,15 @@
 // ==================================================================================
 #include "Image.h"
 
+#include "CookedImage.h"
+#include "PixelKernels.h"
+#include "TextureUploadQueue.h"
+#include "TiledTexture.h"
 #include "../Math/Rectangle.h"
+#include "../Renderer/TextureChange.h"
+#include "../Renderer/TextureUploadThread.h"
 #include "../Filesystem.h"
+#include "../Hash.h"
 #include "../Utility.h"
 
 #if defined(__XCODE_BUILD__)
@@ -21,7 +28,12 @@
 #include <SDL2/SDL_image.h>
 #endif
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <optional>
 #include <utility>
 #include <string>
 #include <stdexcept>
@@ -30,35 +42,224 @@
 using namespace NAS2D;
 
 
-unsigned int generateTexture(SDL_Surface* surface);
-unsigned int generateTexture(void* buffer, int bytesPerPixel, int width, int height);
+namespace
+{
+	struct TextureOptions
+	{
+		bool mipmapped;
+		Image::TextureFormat format;
+		bool dithered;
+	};
+}
+
+
+unsigned int generateTexture(SDL_Surface* surface, const TextureOptions& options);
+unsigned int generateTexture(const void* rgbaPixels, int width, int height, const TextureOptions& options);
 
 
 namespace
 {
 	constexpr bool isBigEndian = SDL_BYTEORDER == SDL_BIG_ENDIAN;
 
+	struct GlTextureFormat
+	{
+		GLint internalFormat;
+		GLenum format;
+		GLenum type;
+		std::size_t bytesPerPixel;
+	};
+
+	GlTextureFormat glTextureFormat(Image::TextureFormat format)
+	{
+		switch (format)
+		{
+		case Image::TextureFormat::Rgb565:
+			return {GL_RGB5, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, 2};
+		case Image::TextureFormat::Rgba4444:
+			return {GL_RGBA4, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4, 2};
+		case Image::TextureFormat::Alpha8:
+			return {GL_ALPHA8, GL_ALPHA, GL_UNSIGNED_BYTE, 1};
+		case Image::TextureFormat::Luminance8:
+			return {GL_LUMINANCE8, GL_LUMINANCE, GL_UNSIGNED_BYTE, 1};
+		case Image::TextureFormat::Rgba8:
+		default:
+			return {GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4};
+		}
+	}
+
+	void texImageCompact(const Color* rgbaPixels, Vector<int> size, const TextureOptions& options);
+
+	bool canGenerateMipmaps()
+	{
+		return GLEW_VERSION_3_0 || GLEW_ARB_framebuffer_object;
+	}
+
+	void generateMipmaps(const Color* rgbaPixels, Vector<int> size, GLint internalFormat);
+
+	std::atomic<Image::SurfaceRetention> defaultRetention{Image::SurfaceRetention::Keep};
+	std::atomic<std::size_t> surfaceBytes{0};
+	std::atomic<Image::TextureFormat> defaultFormat{Image::TextureFormat::Rgba8};
+	std::atomic<std::size_t> compactTextureBytes{0};
+
+	std::size_t surfaceByteCount(const SDL_Surface* surface)
+	{
+		return surface ? static_cast<std::size_t>(surface->pitch) * static_cast<std::size_t>(surface->h) : 0;
+	}
+
 	unsigned int generateFbo(unsigned int textureId, Vector<int> imageSize);
 	unsigned int readPixelValue(std::uintptr_t pixelAddress, unsigned int bytesPerPixel);
+
+
+	/**
+	 * Converts rows of a surface to tightly packed 8 bit RGBA, the layout all textures are uploaded in.
+	 *
+	 * Common formats are converted with the pixel kernels. Anything else is
+	 * converted by SDL up front.
+	 */
+	class RgbaConverter
+	{
+	public:
+		explicit RgbaConverter(SDL_Surface& surface);
+		RgbaConverter(const RgbaConverter&) = delete;
+		RgbaConverter& operator=(const RgbaConverter&) = delete;
+		~RgbaConverter();
+
+		const Color* tightPixels() const;
+		void convertRow(int y, Color* destination) const;
+		bool isOpaque() const;
+
+	private:
+		enum class Layout
+		{
+			Rgba,
+			Bgra,
+			Rgb,
+			Bgr,
+			Palette,
+		};
+
+		static std::optional<Layout> layoutOf(SDL_Surface& surface);
+
+		SDL_Surface* mConvertedSurface{nullptr};
+		SDL_Surface& mSurface;
+		Layout mLayout;
+		bool mIsOpaque{false};
+		std::array<Color, 256> mPalette{};
+	};
+}
+
+
+/**
+ * Sets the surface retention policy of Images created from now on.
+ */
+void Image::setDefaultSurfaceRetention(SurfaceRetention retention)
+{
+	defaultRetention = retention;
+}
+
+
+Image::SurfaceRetention Image::defaultSurfaceRetention()
+{
+	return defaultRetention;
+}
+
+
+/**
+ * Memory used by the decoded pixels of all Images, in bytes.
+ */
+std::size_t Image::retainedSurfaceBytes()
+{
+	return surfaceBytes;
+}
+
+
+/**
+ * Sets the texture format of Images created from now on.
+ */
+void Image::setDefaultTextureFormat(TextureFormat format)
+{
+	defaultFormat = format;
+}
+
+
+Image::TextureFormat Image::defaultTextureFormat()
+{
+	return defaultFormat;
+}
+
+
+/**
+ * Texture memory saved by compact texture formats, compared to 8 bit RGBA, in bytes.
+ */
+std::size_t Image::compactTextureBytesSaved()
+{
+	return compactTextureBytes;
+}
+
+
+/**
+ * Hash of the contents of an image file, to find identical images under different paths.
+ *
+ * For use with ResourceCache::shareIdenticalContent().
+ */
+uint64_t Image::fileContentHash(const std::string& filePath)
+{
+	const auto file = Utility<Filesystem>::get().mapFile(filePath);
+	const auto data = file.data();
+	return xxHash64(data.data(), data.size(), 0);
+}
+
+
+/**
+ * Whether two image files have identical contents, to confirm a fileContentHash() match.
+ *
+ * For use with ResourceCache::shareIdenticalContent().
+ */
+bool Image::fileContentEqual(const std::string& filePath1, const std::string& filePath2)
+{
+	auto& filesystem = Utility<Filesystem>::get();
+	const auto file1 = filesystem.mapFile(filePath1);
+	const auto file2 = filesystem.mapFile(filePath2);
+	const auto data1 = file1.data();
+	const auto data2 = file2.data();
+	return std::equal(data1.begin(), data1.end(), data2.begin(), data2.end());
 }
 
 
-SDL_Surface* Image::fileToSdlSurface(const std::string& filePath)
+/**
+ * Memory used by the pixels of an image once decoded, in bytes.
+ *
+ * For use with ResourceCache::shareIdenticalContent().
+ */
+std::size_t Image::decodedByteCount(const Image& image)
 {
-	const auto& data = Utility<Filesystem>::get().readFile(filePath);
+	const auto size = image.size().to<std::size_t>();
+	return size.x * size.y * sizeof(Color);
+}
 
-	if (data.size() == 0)
+
+SDL_Surface* Image::mappedFileToSdlSurface(const MappedFile& file)
+{
+	const auto cookedImage = parseCookedImage(file.data());
+	if (!cookedImage)
 	{
-		throw std::runtime_error("Image file is empty: " + filePath);
+		return dataToSdlSurface(file.data());
 	}
 
-	return dataToSdlSurface(data);
+	// Surface uses the mapped pixels in place, so the file must stay mapped
+	const auto size = cookedImage->size;
+	auto* surface = SDL_CreateRGBSurfaceWithFormatFrom(cookedImage->pixels.data(), size.x, size.y, 32, size.x * 4, SDL_PIXELFORMAT_RGBA32);
+	if (!surface)
+	{
+		throw std::runtime_error("Image failed to load: " + std::string{SDL_GetError()});
+	}
+	return surface;
 }
 
 
-SDL_Surface* Image::dataToSdlSurface(const std::string& data)
+SDL_Surface* Image::dataToSdlSurface(std::span<const std::byte> data)
 {
-	auto surface = IMG_Load_RW(SDL_RWFromConstMem(data.c_str(), static_cast<int>(data.size())), 1);
+	auto surface = IMG_Load_RW(SDL_RWFromConstMem(data.data(), static_cast<int>(data.size())), 1);
 	if (!surface)
 	{
 		throw std::runtime_error("Image failed to load: " + std::string{SDL_GetError()});
@@ -79,7 +280,14 @@ SDL_Surface* Image::dataToSdlSurface(void* buffer, int bytesPerPixel, Vector<int
 		throw std::runtime_error("Image bit-depth unsupported with bytesPerPixel: " + std::to_string(bytesPerPixel));
 	}
 
-	return SDL_CreateRGBSurfaceFrom(buffer, size.x, size.y, bytesPerPixel * 8, 0, 0, 0, 0, isBigEndian ? 0x000000FF : 0xFF000000);
+	// Bytes are in RGB(A) order, which masks can't describe for 24 bits or without an alpha channel
+	const auto format = (bytesPerPixel == 4) ? SDL_PIXELFORMAT_RGBA32 : SDL_PIXELFORMAT_RGB24;
+	auto surface = SDL_CreateRGBSurfaceWithFormatFrom(buffer, size.x, size.y, bytesPerPixel * 8, size.x * bytesPerPixel, format);
+	if (!surface)
+	{
+		throw std::runtime_error("Image failed to create surface: " + std::string{SDL_GetError()});
+	}
+	return surface;
 }
 
 
@@ -89,15 +297,26 @@ SDL_Surface* Image::dataToSdlSurface(void* buffer, int bytesPerPixel, Vector<int
  * \param filePath Path to an image file.
  */
 Image::Image(const std::string& filePath) :
-	Image{*fileToSdlSurface(filePath)}
+	Image{Utility<Filesystem>::get().mapFile(filePath)}
 {
 }
 
 
+Image::Image(MappedFile file) :
+	Image{*mappedFileToSdlSurface(file)}
+{
+	// Decoded images have their own copy of the pixels
+	if (parseCookedImage(file.data()))
+	{
+		mMappedFile = std::make_unique<MappedFile>(std::move(file));
+	}
+}
+
+
 /**
  * Create an Image from a raw data buffer.
  *
- * \param	buffer			Pointer to a data buffer.
+ * \param	buffer			Pointer to a data buffer, of tightly packed rows of pixels in RGB or RGBA byte order.
  * \param	bytesPerPixel	Number of bytes per pixel. Valid values are 3 and 4 (images < 24-bit are not supported).
  * \param	size			Size of the Image in pixels.
  */
@@ -109,23 +328,31 @@ Image::Image(void* buffer, int bytesPerPixel, Vector<int> size) :
 
 Image::Image(SDL_Surface& surface) :
 	mSurface{&surface},
+	mSurfaceRetention{defaultRetention},
+	mTextureFormat{defaultFormat},
+	mIsOpaque{RgbaConverter{surface}.isOpaque()},
 	mSize{mSurface->w, mSurface->h}
 {
+	surfaceBytes += surfaceByteCount(mSurface);
 }
 
 
 Image::~Image()
 {
+	cancelUpload();
+
 	if (mFrameBufferObjectId != 0)
 	{
 		glDeleteFramebuffers(1, &mFrameBufferObjectId);
 	}
 	if (mTextureId != 0)
 	{
+		beforeTextureChange(mTextureId);
 		glDeleteTextures(1, &mTextureId);
+		compactTextureBytes -= mTextureBytesSaved;
 	}
 
-	SDL_FreeSurface(mSurface);
+	replaceSurface(nullptr);
 }
 
 
@@ -141,6 +368,8 @@ Vector<int> Image::size() const
 /**
  * Gets the color of a pixel at a given coordinate.
  *
+ * \note	Locks the image for each call. Use pixels() to read many pixels.
+ *
  * \param	point	Coordinates of the pixel to check.
  */
 Color Image::pixelColor(Point<int> point) const
@@ -150,6 +379,7 @@ Color Image::pixelColor(Point<int> point) const
 		throw std::runtime_error("Pixel coordinates out of bounds: {" + std::to_string(point.x) + ", " + std::to_string(point.y) + "}");
 	}
 
+	restoreSurface();
 	if (!mSurface) { throw std::runtime_error("Image has no allocated surface"); }
 
 	uint8_t bytesPerPixel = mSurface->format->BytesPerPixel;
@@ -168,16 +398,471 @@ Color Image::pixelColor(Point<int> point) const
 }
 
 
+/**
+ * Gets the alpha value of a pixel at a given coordinate.
+ *
+ * Uses the alpha mask of images with the AlphaMask retention policy, and
+ * avoids reading the texture back.
+ *
+ * \param	point	Coordinates of the pixel to check.
+ */
+uint8_t Image::pixelAlpha(Point<int> point) const
+{
+	if (mSurface || mAlphaMask.empty())
+	{
+		return pixelColor(point).alpha;
+	}
+
+	if (!Rectangle{{0, 0}, mSize}.contains(point))
+	{
+		throw std::runtime_error("Pixel coordinates out of bounds: {" + std::to_string(point.x) + ", " + std::to_string(point.y) + "}");
+	}
+
+	const auto unsignedPoint = point.to<std::size_t>();
+	return mAlphaMask[unsignedPoint.y * static_cast<std::size_t>(mSize.x) + unsignedPoint.x];
+}
+
+
+/**
+ * Gives direct read access to the pixels of the image.
+ *
+ * Images not already stored as 8 bit RGBA are converted on the first call.
+ *
+ * \note	The view must be destroyed before the image is next drawn, in
+ *			case drawing uploads the image and releases its surface.
+ */
+ImagePixels Image::pixels() const
+{
+	restoreSurface();
+	if (!mSurface) { throw std::runtime_error("Image has no allocated surface"); }
+
+	if (mSurface->format->format != SDL_PIXELFORMAT_RGBA32)
+	{
+		auto* convertedSurface = SDL_ConvertSurfaceFormat(mSurface, SDL_PIXELFORMAT_RGBA32, 0);
+		if (!convertedSurface)
+		{
+			throw std::runtime_error("Image pixel format conversion failed: " + std::string{SDL_GetError()});
+		}
+		replaceSurface(convertedSurface);
+	}
+
+	return ImagePixels{*mSurface};
+}
+
+
+/**
+ * Whether every pixel is fully opaque, so the image can be drawn without blending.
+ *
+ * Checked when the image is created. Images drawn onto with translucent
+ * pixels are no longer opaque. Textures in Rgb565 or Luminance8 format have
+ * no alpha, so are always opaque.
+ */
+bool Image::isOpaque() const
+{
+	return mIsOpaque || mTextureFormat == TextureFormat::Rgb565 || mTextureFormat == TextureFormat::Luminance8;
+}
+
+
+/**
+ * Creates the texture for the image now, instead of on first draw.
+ *
+ * Call during loading so the first frame that draws the image doesn't stall
+ * on the upload. See TextureUploadQueue to spread uploads across frames.
+ */
+void Image::upload() const
+{
+	// Tiles are uploaded as they are drawn
+	if (!isTiled())
+	{
+		textureId();
+	}
+}
+
+
+bool Image::isUploaded() const
+{
+	return mTextureId != 0;
+}
+
+
+/**
+ * Sets what to keep of the decoded pixels once the image is uploaded.
+ *
+ * Takes effect at the next upload. Images already uploaded keep their pixels.
+ *
+ * \note	Images with a compact TextureFormat keep their pixels whatever the
+ *			policy, as reading them back from the texture would not return what
+ *			was loaded.
+ */
+void Image::setSurfaceRetention(SurfaceRetention retention)
+{
+	mSurfaceRetention = retention;
+}
+
+
+Image::SurfaceRetention Image::surfaceRetention() const
+{
+	return mSurfaceRetention;
+}
+
+
+/**
+ * Sets whether the texture gets mipmaps, for drawing smaller than full size without shimmering.
+ *
+ * Mipmaps use a third more texture memory. They are generated on the GPU when
+ * supported, and with a box filter on the CPU otherwise. The renderer switches
+ * to mipmap filtering whenever the image is drawn scaled down.
+ *
+ * \note	Takes effect at the next upload, so call before the image is first drawn.
+ */
+void Image::setMipmapped(bool mipmapped)
+{
+	mIsMipmapped = mipmapped;
+}
+
+
+bool Image::isMipmapped() const
+{
+	return mIsMipmapped;
+}
+
+
+/**
+ * Sets the format the texture stores pixels in.
+ *
+ * Compact formats use a half or a quarter of the texture memory and upload
+ * bandwidth, for art that looks the same with fewer bits, such as opaque
+ * backgrounds or shadows. Pixels are converted on the CPU before upload.
+ *
+ * \param	format		Format of the texture.
+ * \param	dithered	Whether to apply an ordered dither when reducing to 16
+ *						bit formats, which hides banding in gradients.
+ *
+ * Compact formats keep their decoded pixels whatever the SurfaceRetention, see
+ * setSurfaceRetention().
+ *
+ * \note	Takes effect at the next upload, so call before the image is first drawn.
+ */
+void Image::setTextureFormat(TextureFormat format, bool dithered)
+{
+	mTextureFormat = format;
+	mIsDithered = dithered;
+}
+
+
+Image::TextureFormat Image::textureFormat() const
+{
+	return mTextureFormat;
+}
+
+
+bool Image::isDithered() const
+{
+	return mIsDithered;
+}
+
+
 unsigned int Image::textureId() const
 {
 	if (mTextureId == 0)
 	{
-		mTextureId = generateTexture(mSurface);
+		if (isTiled())
+		{
+			throw std::runtime_error("Image is too large for a single texture: " + std::to_string(mSize.x) + "x" + std::to_string(mSize.y));
+		}
+		// Drawn before its queued upload finished, so upload it here instead
+		cancelUpload();
+		mTextureId = generateTexture(mSurface, {mIsMipmapped, mTextureFormat, mIsDithered});
+		mHasMipmapLevels = mIsMipmapped;
+		onUploaded();
 	}
 	return mTextureId;
 }
 
 
+/**
+ * Number of bytes sent to the GPU when the image is uploaded.
+ */
+std::size_t Image::uploadByteCount() const
+{
+	return mSize.to<std::size_t>().x * mSize.to<std::size_t>().y * glTextureFormat(mTextureFormat).bytesPerPixel;
+}
+
+
+/**
+ * Uploads the image through a pixel buffer object.
+ *
+ * Pixels are copied into driver owned memory, and the transfer into the
+ * texture can proceed without blocking the calling thread.
+ *
+ * \param	pixelBufferId	Pixel buffer object to stage the pixels in.
+ */
+void Image::uploadStreamed(unsigned int pixelBufferId) const
+{
+	// Compact formats are converted on the CPU. Without GPU mipmap generation, the
+	// CPU also needs the pixels to build the mipmaps.
+	if (mTextureId != 0 || mTextureFormat != TextureFormat::Rgba8 || (mIsMipmapped && !canGenerateMipmaps()))
+	{
+		textureId();
+		return;
+	}
+
+	{
+		const RgbaConverter converter{*mSurface};
+
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBufferId);
+		// Orphan the previous contents, so the driver doesn't wait for an earlier transfer to finish
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(uploadByteCount()), nullptr, GL_STREAM_DRAW);
+		auto* bufferPixels = static_cast<Color*>(glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY));
+		if (bufferPixels)
+		{
+			// Converted straight into driver memory
+			for (int y = 0; y < mSize.y; ++y)
+			{
+				converter.convertRow(y, bufferPixels + static_cast<std::size_t>(y) * static_cast<std::size_t>(mSize.x));
+			}
+
+			// Texture data is read from offset 0 of the bound pixel buffer
+			if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE)
+			{
+				mTextureId = generateTexture(nullptr, mSize.x, mSize.y, {mIsMipmapped, mTextureFormat, mIsDithered});
+				mHasMipmapLevels = mIsMipmapped;
+			}
+		}
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+
+	if (mTextureId != 0)
+	{
+		onUploaded();
+		return;
+	}
+
+	// Mapping can fail, or the buffer contents can be lost. Fall back to a direct upload.
+	textureId();
+}
+
+
+/**
+ * Creates a texture from the image without attaching it to the image.
+ *
+ * Only reads the image, so it can be called from a thread with a shared GL context.
+ */
+unsigned int Image::createTexture() const
+{
+	return generateTexture(mSurface, {mIsMipmapped, mTextureFormat, mIsDithered});
+}
+
+
+/**
+ * Attaches a texture created by createTexture(). Deletes it if the image
+ * was uploaded in the meantime.
+ */
+void Image::adoptTexture(unsigned int textureId) const
+{
+	if (mTextureId != 0)
+	{
+		glDeleteTextures(1, &textureId);
+		return;
+	}
+	mTextureId = textureId;
+	mHasMipmapLevels = mIsMipmapped;
+	onUploaded();
+}
+
+
+/**
+ * Switches between mipmap and plain filtering, as the image is drawn smaller or not.
+ *
+ * Plain filtering is sharper at full size and larger.
+ */
+void Image::setMinificationFilter(bool isMinified) const
+{
+	if (!mHasMipmapLevels || isMinified == mIsMinified)
+	{
+		return;
+	}
+
+	glBindTexture(GL_TEXTURE_2D, mTextureId);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, isMinified ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+	mIsMinified = isMinified;
+}
+
+
+/**
+ * Whether setMinificationFilter() would change the filter of the texture.
+ */
+bool Image::changesMinificationFilter(bool isMinified) const
+{
+	return mHasMipmapLevels && isMinified != mIsMinified;
+}
+
+
+/**
+ * Whether the image exceeds the maximum texture size, and is drawn from tiles().
+ */
+bool Image::isTiled() const
+{
+	return TileGrid::needsTiling(mSize, TiledTexture::maxTextureSize());
+}
+
+
+TiledTexture& Image::tiles() const
+{
+	if (!mTiles)
+	{
+		mTiles = std::make_unique<TiledTexture>(mSize, [this](const Rectangle<int>& rect, std::span<Color> destination) {
+			pixels().copyRect(rect, destination);
+		});
+	}
+	return *mTiles;
+}
+
+
+/**
+ * Regenerates mipmaps after the texture is drawn to.
+ *
+ * Without GPU mipmap generation the smaller levels keep their old contents.
+ */
+void Image::updateMipmaps() const
+{
+	if (mHasMipmapLevels && canGenerateMipmaps())
+	{
+		glBindTexture(GL_TEXTURE_2D, mTextureId);
+		glGenerateMipmap(GL_TEXTURE_2D);
+	}
+}
+
+
+void Image::replaceSurface(SDL_Surface* surface) const
+{
+	// The loader thread may be reading the surface being freed
+	cancelUpload();
+
+	surfaceBytes -= surfaceByteCount(mSurface);
+	surfaceBytes += surfaceByteCount(surface);
+	SDL_FreeSurface(mSurface);
+	mSurface = surface;
+	// Only the original surface can use mapped pixels
+	mMappedFile.reset();
+}
+
+
+/**
+ * Frees decoded pixels that no longer match the texture.
+ *
+ * Pixels are downloaded from the texture again when next read.
+ */
+void Image::invalidateSurface() const
+{
+	if (mTextureId != 0)
+	{
+		replaceSurface(nullptr);
+		mAlphaMask.clear();
+	}
+}
+
+
+/**
+ * Replaces pixels of an image that isn't uploaded yet, in its surface.
+ *
+ * \param	rect	Area of the image to replace, which must be within the image.
+ * \param	pixels	Tightly packed rows of RGBA pixels, covering the area.
+ */
+void Image::writeSurface(const Rectangle<int>& rect, const Color* pixels)
+{
+	// Converts the surface to RGBA, if it isn't already
+	this->pixels();
+	cancelUpload();
+
+	const auto rowBytes = static_cast<std::size_t>(rect.size.x) * sizeof(Color);
+	for (int y = 0; y < rect.size.y; ++y)
+	{
+		auto* destination = static_cast<uint8_t*>(mSurface->pixels) + static_cast<std::size_t>(rect.position.y + y) * static_cast<std::size_t>(mSurface->pitch) + static_cast<std::size_t>(rect.position.x) * sizeof(Color);
+		std::memcpy(destination, pixels + static_cast<std::size_t>(y) * static_cast<std::size_t>(rect.size.x), rowBytes);
+	}
+
+	mAlphaMask.clear();
+	mIsOpaque = mIsOpaque && allOpaque(pixels, static_cast<std::size_t>(rect.size.x) * static_cast<std::size_t>(rect.size.y));
+}
+
+
+/**
+ * Clears the opaque flag after pixels that may be translucent are drawn onto the image.
+ */
+void Image::markTranslucent() const
+{
+	mIsOpaque = false;
+}
+
+
+/**
+ * Downloads the pixels of an image whose surface was released.
+ */
+void Image::restoreSurface() const
+{
+	if (mSurface || mTextureId == 0)
+	{
+		return;
+	}
+
+	auto* surface = SDL_CreateRGBSurfaceWithFormat(0, mSize.x, mSize.y, 32, SDL_PIXELFORMAT_RGBA32);
+	if (!surface)
+	{
+		throw std::runtime_error("Image surface creation failed: " + std::string{SDL_GetError()});
+	}
+
+	glBindTexture(GL_TEXTURE_2D, mTextureId);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, surface->pixels);
+
+	replaceSurface(surface);
+	mAlphaMask.clear();
+}
+
+
+/**
+ * Applies the surface retention policy once the texture exists.
+ */
+void Image::onUploaded() const
+{
+	const auto pixelCount = mSize.to<std::size_t>().x * mSize.to<std::size_t>().y;
+	mTextureBytesSaved = pixelCount * (sizeof(Color) - glTextureFormat(mTextureFormat).bytesPerPixel);
+	compactTextureBytes += mTextureBytesSaved;
+
+	// Compact formats lose precision or color, so their pixels can't be restored from the texture
+	if (mSurfaceRetention == SurfaceRetention::Keep || mTextureFormat != TextureFormat::Rgba8)
+	{
+		return;
+	}
+
+	if (mSurfaceRetention == SurfaceRetention::AlphaMask)
+	{
+		mAlphaMask.resize(pixelCount);
+		pixels().copyChannel({{0, 0}, mSize}, ColorChannel::Alpha, mAlphaMask);
+	}
+	replaceSurface(nullptr);
+}
+
+
+/**
+ * Removes the image from the TextureUploadThread or TextureUploadQueue it is queued on, if any.
+ *
+ * Waits for an upload in progress to finish, so the surface is no longer in use.
+ */
+void Image::cancelUpload() const
+{
+	if (mUploadThread)
+	{
+		mUploadThread->cancel(*this);
+	}
+	if (mUploadQueue)
+	{
+		mUploadQueue->cancel(*this);
+	}
+}
+
+
 unsigned int Image::frameBufferObjectId() const
 {
 	if (mFrameBufferObjectId == 0)
@@ -240,55 +925,320 @@ namespace
 }
 
 
-/**
- * Generates a new OpenGL texture from an SDL_Surface.
- */
-unsigned int generateTexture(SDL_Surface* surface)
+namespace
 {
-	const auto bytesPerPixel = surface->format->BytesPerPixel;
-	if (bytesPerPixel == 3 || bytesPerPixel == 4)
+	/**
+	 * Position of a color channel within a 4 byte pixel, in memory order.
+	 */
+	std::optional<int> byteIndex(uint32_t mask)
 	{
-		return generateTexture(surface->pixels, bytesPerPixel, surface->w, surface->h);
+		for (int i = 0; i < 4; ++i)
+		{
+			if (mask == (0xFFu << (i * 8)))
+			{
+				return isBigEndian ? 3 - i : i;
+			}
+		}
+		return {};
 	}
 
-	auto* newSurface = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
-	const auto textureId = generateTexture(newSurface->pixels, newSurface->format->BytesPerPixel, newSurface->w, newSurface->h);
-	SDL_FreeSurface(newSurface);
-	return textureId;
+
+	RgbaConverter::RgbaConverter(SDL_Surface& surface) :
+		mSurface{surface},
+		mLayout{Layout::Rgba}
+	{
+		const auto layout = layoutOf(surface);
+		if (layout)
+		{
+			mLayout = *layout;
+		}
+		else
+		{
+			mConvertedSurface = SDL_ConvertSurfaceFormat(&surface, SDL_PIXELFORMAT_RGBA32, 0);
+			if (!mConvertedSurface)
+			{
+				throw std::runtime_error("Image pixel format conversion failed: " + std::string{SDL_GetError()});
+			}
+		}
+
+		const auto& format = *mSurface.format;
+		mIsOpaque = !mConvertedSurface && format.BytesPerPixel == 4 && format.Amask == 0;
+
+		if (mLayout == Layout::Palette)
+		{
+			const auto& palette = *format.palette;
+			for (std::size_t i = 0; i < static_cast<std::size_t>(palette.ncolors) && i < mPalette.size(); ++i)
+			{
+				const auto& color = palette.colors[i];
+				mPalette[i] = {color.r, color.g, color.b, color.a};
+			}
+
+			uint32_t colorKey;
+			if (SDL_GetColorKey(&surface, &colorKey) == 0 && colorKey < mPalette.size())
+			{
+				mPalette[colorKey].alpha = 0;
+			}
+		}
+
+		SDL_LockSurface(mConvertedSurface ? mConvertedSurface : &mSurface);
+	}
+
+
+	RgbaConverter::~RgbaConverter()
+	{
+		SDL_UnlockSurface(mConvertedSurface ? mConvertedSurface : &mSurface);
+		SDL_FreeSurface(mConvertedSurface);
+	}
+
+
+	/**
+	 * Surface pixels, if they are already tightly packed RGBA and can be uploaded in place.
+	 */
+	const Color* RgbaConverter::tightPixels() const
+	{
+		const auto& surface = mConvertedSurface ? *mConvertedSurface : mSurface;
+		const auto isTight = mLayout == Layout::Rgba && !mIsOpaque && static_cast<std::size_t>(surface.pitch) == static_cast<std::size_t>(surface.w) * sizeof(Color);
+		return isTight ? static_cast<const Color*>(surface.pixels) : nullptr;
+	}
+
+
+	void RgbaConverter::convertRow(int y, Color* destination) const
+	{
+		const auto& surface = mConvertedSurface ? *mConvertedSurface : mSurface;
+		const auto* row = static_cast<const uint8_t*>(surface.pixels) + static_cast<std::size_t>(y) * static_cast<std::size_t>(surface.pitch);
+		const auto width = static_cast<std::size_t>(surface.w);
+
+		switch (mLayout)
+		{
+		case Layout::Rgba:
+			std::memcpy(destination, row, width * sizeof(Color));
+			break;
+		case Layout::Bgra:
+			swizzleBgraToRgba(reinterpret_cast<const Color*>(row), destination, width);
+			break;
+		case Layout::Rgb:
+			expandRgbToRgba(row, destination, width);
+			break;
+		case Layout::Bgr:
+			expandRgbToRgba(row, destination, width);
+			swizzleBgraToRgba(destination, destination, width);
+			break;
+		case Layout::Palette:
+			expandPalette(row, mPalette.data(), destination, width);
+			break;
+		}
+
+		if (mIsOpaque)
+		{
+			fillAlpha(destination, width, 255);
+		}
+	}
+
+
+	/**
+	 * Whether every converted pixel has an alpha of 255.
+	 */
+	bool RgbaConverter::isOpaque() const
+	{
+		if (mIsOpaque || mLayout == Layout::Rgb || mLayout == Layout::Bgr)
+		{
+			return true;
+		}
+
+		// Alpha of 4 byte layouts is already in place, palette indices need expanding
+		const auto& surface = mConvertedSurface ? *mConvertedSurface : mSurface;
+		const auto width = static_cast<std::size_t>(surface.w);
+		std::vector<Color> expandedRow(mLayout == Layout::Palette ? width : 0);
+		for (int y = 0; y < surface.h; ++y)
+		{
+			const auto* row = reinterpret_cast<const Color*>(static_cast<const uint8_t*>(surface.pixels) + static_cast<std::size_t>(y) * static_cast<std::size_t>(surface.pitch));
+			if (mLayout == Layout::Palette)
+			{
+				convertRow(y, expandedRow.data());
+				row = expandedRow.data();
+			}
+			if (!allOpaque(row, width))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+
+	/**
+	 * Kernel able to convert the surface, or an empty optional if SDL has to convert it.
+	 */
+	std::optional<RgbaConverter::Layout> RgbaConverter::layoutOf(SDL_Surface& surface)
+	{
+		const auto& format = *surface.format;
+		uint32_t colorKey;
+		const auto hasColorKey = SDL_GetColorKey(&surface, &colorKey) == 0;
+
+		if (SDL_ISPIXELFORMAT_INDEXED(format.format))
+		{
+			return (format.BitsPerPixel == 8 && format.palette) ? std::optional{Layout::Palette} : std::nullopt;
+		}
+
+		// Color keys of other formats are applied by SDL
+		if (hasColorKey)
+		{
+			return {};
+		}
+
+		if (format.format == SDL_PIXELFORMAT_RGB24)
+		{
+			return Layout::Rgb;
+		}
+		if (format.format == SDL_PIXELFORMAT_BGR24)
+		{
+			return Layout::Bgr;
+		}
+
+		if (format.BytesPerPixel == 4)
+		{
+			const auto red = byteIndex(format.Rmask);
+			const auto green = byteIndex(format.Gmask);
+			const auto blue = byteIndex(format.Bmask);
+			const auto alphaInPlace = format.Amask == 0 || byteIndex(format.Amask) == 3;
+			if (red == 0 && green == 1 && blue == 2 && alphaInPlace)
+			{
+				return Layout::Rgba;
+			}
+			if (red == 2 && green == 1 && blue == 0 && alphaInPlace)
+			{
+				return Layout::Bgra;
+			}
+		}
+
+		return {};
+	}
 }
 
 
-unsigned int generateTexture(void* buffer, int bytesPerPixel, int width, int height)
+/**
+ * Generates a new OpenGL texture from an SDL_Surface.
+ *
+ * Surfaces already in tightly packed RGBA are uploaded in place. Others are
+ * converted to it first, so drivers never see a slow upload format.
+ */
+unsigned int generateTexture(SDL_Surface* surface, const TextureOptions& options)
 {
-	GLint internalFormat = 0;
-	GLenum textureFormat = 0;
-	switch (bytesPerPixel)
+	const RgbaConverter converter{*surface};
+	if (const auto* pixels = converter.tightPixels())
 	{
-	case 4:
-		internalFormat = GL_RGBA;
-		textureFormat = isBigEndian ? GL_BGRA : GL_RGBA;
-		break;
-	case 3:
-		internalFormat = GL_RGB;
-		textureFormat = isBigEndian ? GL_BGR : GL_RGB;
-		break;
+		return generateTexture(pixels, surface->w, surface->h, options);
+	}
 
-	default:
-		throw std::runtime_error("Bit-depth unsupported with bytesPerPixel: " + std::to_string(bytesPerPixel));
+	const auto width = static_cast<std::size_t>(surface->w);
+	std::vector<Color> pixels(width * static_cast<std::size_t>(surface->h));
+	for (int y = 0; y < surface->h; ++y)
+	{
+		converter.convertRow(y, pixels.data() + static_cast<std::size_t>(y) * width);
 	}
+	return generateTexture(pixels.data(), surface->w, surface->h, options);
+}
+
 
+/**
+ * Generates a new OpenGL texture from tightly packed 8 bit RGBA pixels.
+ *
+ * \param	rgbaPixels	Pixel data, or an offset into the bound pixel unpack buffer.
+ *						Compact formats, and mipmaps that can't be generated on the
+ *						GPU, need pixel data.
+ */
+unsigned int generateTexture(const void* rgbaPixels, int width, int height, const TextureOptions& options)
+{
 	GLuint textureId;
 	glGenTextures(1, &textureId);
 	glBindTexture(GL_TEXTURE_2D, textureId);
 
 	// Set texture and pixel handling states.
-	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-	glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, textureFormat, GL_UNSIGNED_BYTE, buffer);
+	if (options.format != Image::TextureFormat::Rgba8 && rgbaPixels)
+	{
+		texImageCompact(static_cast<const Color*>(rgbaPixels), {width, height}, options);
+	}
+	else
+	{
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgbaPixels);
+	}
+
+	if (options.mipmapped)
+	{
+		generateMipmaps(static_cast<const Color*>(rgbaPixels), {width, height}, glTextureFormat(options.format).internalFormat);
+	}
 
 	return textureId;
 }
+
+
+namespace
+{
+	/**
+	 * Converts pixels to a compact texture format, and uploads them into the bound texture.
+	 */
+	void texImageCompact(const Color* rgbaPixels, Vector<int> size, const TextureOptions& options)
+	{
+		const auto glFormat = glTextureFormat(options.format);
+		const auto width = static_cast<std::size_t>(size.x);
+		const auto pixelCount = width * static_cast<std::size_t>(size.y);
+
+		// Rows of compact formats aren't padded to 4 bytes
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		if (glFormat.bytesPerPixel == 2)
+		{
+			const auto quantize = options.format == Image::TextureFormat::Rgb565 ? quantizeRgb565 : quantizeRgba4444;
+			std::vector<uint16_t> texels(pixelCount);
+			for (int y = 0; y < size.y; ++y)
+			{
+				const auto offset = static_cast<std::size_t>(y) * width;
+				quantize(rgbaPixels + offset, texels.data() + offset, width, options.dithered ? std::optional{y} : std::nullopt);
+			}
+			glTexImage2D(GL_TEXTURE_2D, 0, glFormat.internalFormat, size.x, size.y, 0, glFormat.format, glFormat.type, texels.data());
+		}
+		else
+		{
+			const auto channel = options.format == Image::TextureFormat::Alpha8 ? ColorChannel::Alpha : ColorChannel::Red;
+			std::vector<uint8_t> texels(pixelCount);
+			extractChannel(rgbaPixels, texels.data(), pixelCount, channel);
+			glTexImage2D(GL_TEXTURE_2D, 0, glFormat.internalFormat, size.x, size.y, 0, glFormat.format, glFormat.type, texels.data());
+		}
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+
+
+	/**
+	 * Fills the mipmap levels of the bound texture.
+	 *
+	 * Levels built on the CPU are uploaded as 8 bit RGBA, which the driver converts to the internal format.
+	 */
+	void generateMipmaps(const Color* rgbaPixels, Vector<int> size, GLint internalFormat)
+	{
+		if (canGenerateMipmaps())
+		{
+			glGenerateMipmap(GL_TEXTURE_2D);
+			return;
+		}
+
+		std::vector<Color> previousLevel;
+		const Color* previousPixels = rgbaPixels;
+		for (int level = 1; size.x > 1 || size.y > 1; ++level)
+		{
+			const auto levelSize = downsampledSize(size);
+			const auto pixelCount = levelSize.to<std::size_t>();
+			std::vector<Color> levelPixels(pixelCount.x * pixelCount.y);
+			downsample2x(previousPixels, size, levelPixels.data());
+			glTexImage2D(GL_TEXTURE_2D, level, internalFormat, levelSize.x, levelSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, levelPixels.data());
+
+			previousLevel = std::move(levelPixels);
+			previousPixels = previousLevel.data();
+			size = levelSize;
+		}
+	}
+}
@@ -9,11 +9,19 @@
 // ==================================================================================
 #pragma once
 
+#include "ImagePixels.h"
+
 #include "../Renderer/Color.h"
 #include "../Math/Point.h"
+#include "../Math/Rectangle.h"
 #include "../Math/Vector.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
 #include <string>
+#include <vector>
 
 
 struct SDL_Surface;
@@ -21,6 +29,11 @@ struct SDL_Surface;
 
 namespace NAS2D
 {
+	class MappedFile;
+	class TiledTexture;
+	class TextureUploadQueue;
+	class TextureUploadThread;
+
 
 	/**
 	 * Image Class
@@ -33,12 +46,62 @@ namespace NAS2D
 	 * - TGA
 	 * - TIFF
 	 * - WEBP
+	 *
+	 * Images drawn smaller than their size can use mipmaps, see setMipmapped().
+	 * Art that doesn't need full precision can use a compact TextureFormat, see
+	 * setTextureFormat().
+	 *
+	 * Images larger than the driver's maximum texture size are split into a
+	 * TiledTexture. Only tiles that are drawn get uploaded, and tiles not drawn
+	 * recently are evicted. Such images always keep their decoded pixels. They
+	 * can be drawn with any of the Renderer draw functions, but drawing them to
+	 * an image, or to them, with drawImageToImage() or drawTextToImage() throws.
+	 *
+	 * Files in the cooked image format, written by cookImageFile(), are also
+	 * loaded. Their pixels are memory mapped and uploaded in place.
+	 *
+	 * \section SurfaceRetention Surface Retention
+	 *
+	 * Decoded pixels are kept in memory after the texture is created, so they can
+	 * be read back with pixelColor() and pixels(). A SurfaceRetention policy other
+	 * than Keep frees them after upload instead. Reading pixels of such an image
+	 * downloads them from the texture, and keeps them again. Images with a compact
+	 * TextureFormat always keep their pixels, which the texture can't reproduce.
 	 */
 	class Image
 	{
+	public:
+		enum class SurfaceRetention
+		{
+			Keep, // Keep the decoded pixels
+			AlphaMask, // Keep only the alpha channel, for pixelAlpha()
+			Release, // Keep nothing
+		};
+
+		enum class TextureFormat
+		{
+			Rgba8, // Full precision, 4 bytes per pixel
+			Rgb565, // Opaque, 2 bytes per pixel
+			Rgba4444, // 4 bits per channel, 2 bytes per pixel
+			Alpha8, // Alpha only, colored by the draw color, 1 byte per pixel
+			Luminance8, // Opaque greyscale taken from the red channel, 1 byte per pixel
+		};
+
+		static void setDefaultSurfaceRetention(SurfaceRetention retention);
+		static SurfaceRetention defaultSurfaceRetention();
+		static std::size_t retainedSurfaceBytes();
+
+		static void setDefaultTextureFormat(TextureFormat format);
+		static TextureFormat defaultTextureFormat();
+		static std::size_t compactTextureBytesSaved();
+
+		static uint64_t fileContentHash(const std::string& filePath);
+		static bool fileContentEqual(const std::string& filePath1, const std::string& filePath2);
+		static std::size_t decodedByteCount(const Image& image);
+
 	protected:
-		static SDL_Surface* fileToSdlSurface(const std::string& filePath);
-		static SDL_Surface* dataToSdlSurface(const std::string& data);
+		static SDL_Surface* mappedFileToSdlSurface(const MappedFile& file);
+		static SDL_Surface* dataToSdlSurface(std::span<const std::byte> data);
 		static SDL_Surface* dataToSdlSurface(void* buffer, int bytesPerPixel, Vector<int> size);
 
 	public:
@@ -49,21 +112,77 @@ namespace NAS2D
 		Image(const Image& rhs) = delete;
 		Image& operator=(const Image& rhs) = delete;
 
-		~Image();
+		virtual ~Image();
 
 		Vector<int> size() const;
 
 		Color pixelColor(Point<int> point) const;
+		uint8_t pixelAlpha(Point<int> point) const;
+		ImagePixels pixels() const;
+
+		bool isOpaque() const;
+
+		void upload() const;
+		bool isUploaded() const;
+
+		void setSurfaceRetention(SurfaceRetention retention);
+		SurfaceRetention surfaceRetention() const;
+
+		void setMipmapped(bool mipmapped);
+		bool isMipmapped() const;
+
+		void setTextureFormat(TextureFormat format, bool dithered = false);
+		TextureFormat textureFormat() const;
+		bool isDithered() const;
 
 	protected:
 		friend class RendererOpenGL;
 		unsigned int textureId() const;
 		unsigned int frameBufferObjectId() const;
+		void setMinificationFilter(bool isMinified) const;
+		bool changesMinificationFilter(bool isMinified) const;
+		void updateMipmaps() const;
+		bool isTiled() const;
+		TiledTexture& tiles() const;
+
+		friend class TextureUploadQueue;
+		std::size_t uploadByteCount() const;
+		void uploadStreamed(unsigned int pixelBufferId) const;
+
+		friend class TextureUploadThread;
+		unsigned int createTexture() const;
+		void adoptTexture(unsigned int textureId) const;
+
+		void invalidateSurface() const;
+		void markTranslucent() const;
+		void writeSurface(const Rectangle<int>& rect, const Color* pixels);
 
 	private:
-		SDL_Surface* mSurface{nullptr};
+		explicit Image(MappedFile file);
+
+		void replaceSurface(SDL_Surface* surface) const;
+		void restoreSurface() const;
+		void onUploaded() const;
+		void cancelUpload() const;
+
+		mutable SDL_Surface* mSurface{nullptr};
+		mutable std::unique_ptr<MappedFile> mMappedFile{};
+		mutable std::vector<uint8_t> mAlphaMask{};
+		mutable std::unique_ptr<TiledTexture> mTiles{};
+		SurfaceRetention mSurfaceRetention;
+		bool mIsMipmapped{false};
+		TextureFormat mTextureFormat;
+		bool mIsDithered{false};
+		mutable bool mIsOpaque;
+		mutable std::size_t mTextureBytesSaved{0};
+		mutable bool mHasMipmapLevels{false};
+		mutable bool mIsMinified{false};
 		mutable unsigned int mTextureId{0u};
 		mutable unsigned int mFrameBufferObjectId{0u};
+		// Set while queued on a TextureUploadThread, whose loader thread reads the surface
+		mutable TextureUploadThread* mUploadThread{nullptr};
+		// Set while queued on a TextureUploadQueue, so a destroyed image leaves the queue
+		mutable TextureUploadQueue* mUploadQueue{nullptr};
 		Vector<int> mSize{0, 0};
 	};
 
@@ -0,0 +1,179 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "ImagePixels.h"
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+using namespace NAS2D;
+
+
+namespace
+{
+	std::string rectToString(const Rectangle<int>& rect)
+	{
+		return "{" + std::to_string(rect.position.x) + ", " + std::to_string(rect.position.y) + ", " + std::to_string(rect.size.x) + ", " + std::to_string(rect.size.y) + "}";
+	}
+}
+
+
+/**
+ * Locks a surface for reading.
+ *
+ * \param	surface	Surface in SDL_PIXELFORMAT_RGBA32 format, whose memory layout matches Color.
+ */
+ImagePixels::ImagePixels(SDL_Surface& surface) :
+	mSurface{surface},
+	mPixels{nullptr},
+	mPitch{0},
+	mSize{surface.w, surface.h}
+{
+	if (surface.format->format != SDL_PIXELFORMAT_RGBA32)
+	{
+		throw std::runtime_error("ImagePixels requires a surface in RGBA32 format");
+	}
+
+	if (SDL_LockSurface(&mSurface) != 0)
+	{
+		throw std::runtime_error("Failed to lock image pixels: " + std::string{SDL_GetError()});
+	}
+
+	mPixels = static_cast<const Color*>(mSurface.pixels);
+	mPitch = static_cast<std::size_t>(mSurface.pitch) / sizeof(Color);
+}
+
+
+ImagePixels::~ImagePixels()
+{
+	SDL_UnlockSurface(&mSurface);
+}
+
+
+Vector<int> ImagePixels::size() const
+{
+	return mSize;
+}
+
+
+/**
+ * Pixels of a row, from left to right.
+ *
+ * \note	The row index is not bounds checked.
+ */
+std::span<const Color> ImagePixels::row(int y) const
+{
+	return {mPixels + static_cast<std::size_t>(y) * mPitch, static_cast<std::size_t>(mSize.x)};
+}
+
+
+/**
+ * Copies a full row of pixels.
+ *
+ * \param	destination	Buffer with space for exactly one row of pixels.
+ */
+void ImagePixels::copyRow(int y, std::span<Color> destination) const
+{
+	copyRect({{0, y}, {mSize.x, 1}}, destination);
+}
+
+
+/**
+ * Copies an area of pixels, in rows from top to bottom.
+ *
+ * \param	destination	Buffer with space for exactly rect.size.x * rect.size.y pixels.
+ */
+void ImagePixels::copyRect(const Rectangle<int>& rect, std::span<Color> destination) const
+{
+	checkRect(rect, destination.size());
+
+	const auto width = static_cast<std::size_t>(rect.size.x);
+	auto* output = destination.data();
+	for (auto y = rect.position.y; y < rect.endPoint().y; ++y)
+	{
+		const auto source = row(y).subspan(static_cast<std::size_t>(rect.position.x), width);
+		output = std::copy(source.begin(), source.end(), output);
+	}
+}
+
+
+/**
+ * Copies one channel of an area of pixels, in rows from top to bottom.
+ *
+ * Extracting ColorChannel::Alpha gives a coverage mask, such as for collision detection.
+ *
+ * \param	destination	Buffer with space for exactly rect.size.x * rect.size.y values.
+ */
+void ImagePixels::copyChannel(const Rectangle<int>& rect, ColorChannel channel, std::span<uint8_t> destination) const
+{
+	checkRect(rect, destination.size());
+
+	const auto width = static_cast<std::size_t>(rect.size.x);
+	auto* output = destination.data();
+	for (auto y = rect.position.y; y < rect.endPoint().y; ++y)
+	{
+		extractChannel(row(y).data() + rect.position.x, output, width, channel);
+		output += width;
+	}
+}
+
+
+/**
+ * Smallest area within a rect holding every pixel with alpha above a threshold.
+ *
+ * Returns an empty rect at the position of the area if all its pixels are
+ * transparent.
+ */
+Rectangle<int> ImagePixels::opaqueBounds(const Rectangle<int>& rect, uint8_t alphaThreshold) const
+{
+	const auto width = static_cast<std::size_t>(std::max(rect.size.x, 0));
+	checkRect(rect, width * static_cast<std::size_t>(std::max(rect.size.y, 0)));
+
+	std::vector<uint8_t> alpha(width);
+	const auto isOpaque = [alphaThreshold](uint8_t value) { return value > alphaThreshold; };
+
+	auto start = rect.endPoint();
+	auto end = rect.position;
+	for (auto y = rect.position.y; y < rect.endPoint().y; ++y)
+	{
+		extractChannel(row(y).data() + rect.position.x, alpha.data(), width, ColorChannel::Alpha);
+		const auto first = std::find_if(alpha.begin(), alpha.end(), isOpaque);
+		if (first == alpha.end())
+		{
+			continue;
+		}
+		const auto last = std::find_if(alpha.rbegin(), alpha.rend(), isOpaque);
+
+		start = {std::min(start.x, rect.position.x + static_cast<int>(first - alpha.begin())), std::min(start.y, y)};
+		end = {std::max(end.x, rect.endPoint().x - static_cast<int>(last - alpha.rbegin())), y + 1};
+	}
+
+	return start < end ? Rectangle<int>::Create(start, end) : Rectangle<int>{rect.position, {0, 0}};
+}
+
+
+void ImagePixels::checkRect(const Rectangle<int>& rect, std::size_t destinationSize) const
+{
+	if (rect.size.x < 0 || rect.size.y < 0 || !Rectangle<int>{{0, 0}, mSize}.contains(rect))
+	{
+		throw std::runtime_error("Pixel area out of bounds: " + rectToString(rect));
+	}
+
+	const auto rectSize = rect.size.to<std::size_t>();
+	if (destinationSize != rectSize.x * rectSize.y)
+	{
+		throw std::runtime_error("Pixel buffer size " + std::to_string(destinationSize) + " does not match area: " + rectToString(rect));
+	}
+}
@@ -0,0 +1,77 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include "PixelKernels.h"
+
+#include "../Renderer/Color.h"
+#include "../Math/Point.h"
+#include "../Math/Rectangle.h"
+#include "../Math/Vector.h"
+
+#include <cstdint>
+#include <span>
+
+
+struct SDL_Surface;
+
+
+namespace NAS2D
+{
+	/**
+	 * Read only view of the pixels of an Image, as rows of RGBA Colors.
+	 *
+	 * The pixels stay locked while the view exists. Element access is not
+	 * bounds checked, the bulk copy functions check their area once per call.
+	 *
+	 * \code{.cpp}
+	 * const auto pixels = image.pixels();
+	 * for (int y = 0; y < pixels.size().y; ++y)
+	 * {
+	 * 	for (const auto color : pixels.row(y))
+	 * 	{
+	 * 		// ...
+	 * 	}
+	 * }
+	 * \endcode
+	 */
+	class ImagePixels
+	{
+	public:
+		explicit ImagePixels(SDL_Surface& surface);
+		ImagePixels(const ImagePixels&) = delete;
+		ImagePixels& operator=(const ImagePixels&) = delete;
+		~ImagePixels();
+
+		Vector<int> size() const;
+
+		std::span<const Color> row(int y) const;
+
+		Color operator[](Point<int> point) const
+		{
+			return row(point.y)[static_cast<std::size_t>(point.x)];
+		}
+
+		void copyRow(int y, std::span<Color> destination) const;
+		void copyRect(const Rectangle<int>& rect, std::span<Color> destination) const;
+		void copyChannel(const Rectangle<int>& rect, ColorChannel channel, std::span<uint8_t> destination) const;
+
+		Rectangle<int> opaqueBounds(const Rectangle<int>& rect, uint8_t alphaThreshold = 0) const;
+
+	private:
+		void checkRect(const Rectangle<int>& rect, std::size_t destinationSize) const;
+
+		SDL_Surface& mSurface;
+		const Color* mPixels;
+		std::size_t mPitch;
+		Vector<int> mSize;
+	};
+}
@@ -0,0 +1,178 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include <map>
+#include <list>
+#include <cstddef>
+#include <utility>
+
+
+namespace NAS2D
+{
+
+	/**
+	 * Least recently used cache with a cost based capacity.
+	 *
+	 * Each entry is inserted along with a cost (typically a size in bytes). When
+	 * the sum of entry costs exceeds the capacity, the least recently used entries
+	 * are evicted until the cache fits again. An entry that is larger than the
+	 * whole capacity is still kept until the next insertion.
+	 *
+	 * \note	Values are constructed in place and never moved, so references
+	 *			returned by find and emplace remain valid until the entry is evicted.
+	 */
+	template <typename Key, typename Value>
+	class LruCache
+	{
+	public:
+		explicit LruCache(std::size_t capacity) :
+			mCapacity{capacity}
+		{}
+
+		LruCache(const LruCache&) = delete;
+		LruCache& operator=(const LruCache&) = delete;
+
+
+		/**
+		 * Looks up an entry, and marks it as most recently used.
+		 *
+		 * \return Pointer to the cached value, or nullptr if not found.
+		 */
+		Value* find(const Key& key)
+		{
+			const auto iter = mIndex.find(key);
+			if (iter == mIndex.end())
+			{
+				++mMisses;
+				return nullptr;
+			}
+
+			++mHits;
+			mEntries.splice(mEntries.begin(), mEntries, iter->second);
+			return &iter->second->value;
+		}
+
+
+		/**
+		 * Constructs a new entry in place, evicting older entries as needed.
+		 *
+		 * An existing entry with the same key is replaced.
+		 */
+		template <typename... Args>
+		Value& emplace(const Key& key, std::size_t cost, Args&&... args)
+		{
+			erase(key);
+			evictUntilAvailable(cost);
+
+			mEntries.emplace_front(key, cost, std::forward<Args>(args)...);
+			mIndex.emplace(key, mEntries.begin());
+			mUsage += cost;
+			return mEntries.front().value;
+		}
+
+
+		void erase(const Key& key)
+		{
+			const auto iter = mIndex.find(key);
+			if (iter != mIndex.end())
+			{
+				mUsage -= iter->second->cost;
+				mEntries.erase(iter->second);
+				mIndex.erase(iter);
+			}
+		}
+
+
+		/**
+		 * Removes all entries for which the predicate returns true.
+		 */
+		template <typename Predicate>
+		void eraseIf(Predicate predicate)
+		{
+			for (auto iter = mEntries.begin(); iter != mEntries.end();)
+			{
+				if (predicate(iter->key))
+				{
+					mUsage -= iter->cost;
+					mIndex.erase(iter->key);
+					iter = mEntries.erase(iter);
+				}
+				else
+				{
+					++iter;
+				}
+			}
+		}
+
+
+		void clear()
+		{
+			mIndex.clear();
+			mEntries.clear();
+			mUsage = 0;
+		}
+
+
+		void capacity(std::size_t newCapacity)
+		{
+			mCapacity = newCapacity;
+			evictUntilAvailable(0);
+		}
+
+		std::size_t capacity() const { return mCapacity; }
+		std::size_t usage() const { return mUsage; }
+		std::size_t size() const { return mEntries.size(); }
+
+		std::size_t hits() const { return mHits; }
+		std::size_t misses() const { return mMisses; }
+		std::size_t evictions() const { return mEvictions; }
+
+	private:
+		struct Entry
+		{
+			template <typename... Args>
+			Entry(const Key& entryKey, std::size_t entryCost, Args&&... args) :
+				key{entryKey},
+				cost{entryCost},
+				value{std::forward<Args>(args)...}
+			{}
+
+			Key key;
+			std::size_t cost;
+			Value value;
+		};
+
+
+		void evictUntilAvailable(std::size_t cost)
+		{
+			while (!mEntries.empty() && mUsage + cost > mCapacity)
+			{
+				const auto& entry = mEntries.back();
+				mUsage -= entry.cost;
+				mIndex.erase(entry.key);
+				mEntries.pop_back();
+				++mEvictions;
+			}
+		}
+
+
+		std::size_t mCapacity;
+		std::size_t mUsage{0};
+		std::list<Entry> mEntries{};
+		std::map<Key, typename std::list<Entry>::iterator> mIndex{};
+
+		std::size_t mHits{0};
+		std::size_t mMisses{0};
+		std::size_t mEvictions{0};
+	};
+
+} // namespace
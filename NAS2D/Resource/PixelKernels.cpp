@@ -0,0 +1,714 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "PixelKernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NAS2D_SSE2
+#include <emmintrin.h>
+#endif
+
+// MSVC has no SSSE3 switch, but AVX2 builds imply it
+#if defined(__SSSE3__) || defined(__AVX2__)
+#define NAS2D_SSSE3
+#include <tmmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define NAS2D_AVX2
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+
+using namespace NAS2D;
+
+
+static_assert(sizeof(Color) == 4, "Pixel kernels expect tightly packed 8 bit RGBA colors");
+
+
+/**
+ * Copies one channel of a row of pixels into a byte array.
+ *
+ * Uses SSE2 when the target supports it, processing 16 pixels at a time.
+ *
+ * \param	pixels		Source pixels.
+ * \param	destination	Array of at least count bytes.
+ * \param	count		Number of pixels.
+ * \param	channel		Channel to extract, such as ColorChannel::Alpha for a coverage mask.
+ */
+void NAS2D::extractChannel(const Color* pixels, uint8_t* destination, std::size_t count, ColorChannel channel)
+{
+	std::size_t index = 0;
+
+#if defined(NAS2D_SSE2)
+	// Color is stored as bytes R, G, B, A, so each channel is a fixed byte of a little endian 32 bit lane
+	const auto shift = _mm_cvtsi32_si128(static_cast<int>(channel) * 8);
+	const auto byteMask = _mm_set1_epi32(0xFF);
+	const auto extract = [shift, byteMask](const Color* source) {
+		const auto colors = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+		return _mm_and_si128(_mm_srl_epi32(colors, shift), byteMask);
+	};
+
+	for (; index + 16 <= count; index += 16)
+	{
+		const auto* source = pixels + index;
+		// Lanes hold values 0 - 255, so the saturating packs narrow them without change
+		const auto low = _mm_packs_epi32(extract(source), extract(source + 4));
+		const auto high = _mm_packs_epi32(extract(source + 8), extract(source + 12));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + index), _mm_packus_epi16(low, high));
+	}
+#endif
+
+	extractChannelScalar(pixels + index, destination + index, count - index, channel);
+}
+
+
+/**
+ * Portable version of extractChannel, which also handles remaining pixels for the SIMD version.
+ */
+void NAS2D::extractChannelScalar(const Color* pixels, uint8_t* destination, std::size_t count, ColorChannel channel)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const auto& color = pixels[i];
+		switch (channel)
+		{
+		case ColorChannel::Red:
+			destination[i] = color.red;
+			break;
+		case ColorChannel::Green:
+			destination[i] = color.green;
+			break;
+		case ColorChannel::Blue:
+			destination[i] = color.blue;
+			break;
+		case ColorChannel::Alpha:
+			destination[i] = color.alpha;
+			break;
+		}
+	}
+}
+
+
+/**
+ * Expands tightly packed 24 bit RGB pixels into opaque RGBA pixels.
+ *
+ * Uses SSSE3 byte shuffles when the target supports it, processing 16 pixels at a time.
+ *
+ * \param	rgb			Source bytes, 3 per pixel.
+ * \param	destination	Array of at least count pixels.
+ * \param	count		Number of pixels.
+ */
+void NAS2D::expandRgbToRgba(const uint8_t* rgb, Color* destination, std::size_t count)
+{
+	std::size_t index = 0;
+
+#if defined(NAS2D_SSSE3)
+	// Spreads 4 packed RGB pixels over 4 lanes, leaving the alpha bytes zero
+	const auto spread = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+	const auto opaque = _mm_set1_epi32(static_cast<int>(0xFF000000));
+	const auto expand = [spread, opaque](__m128i packed) {
+		return _mm_or_si128(_mm_shuffle_epi8(packed, spread), opaque);
+	};
+
+	// 16 pixels are exactly 3 loads, so nothing past the end of the source is read
+	for (; index + 16 <= count; index += 16)
+	{
+		const auto* source = reinterpret_cast<const __m128i*>(rgb + index * 3);
+		const auto a = _mm_loadu_si128(source);
+		const auto b = _mm_loadu_si128(source + 1);
+		const auto c = _mm_loadu_si128(source + 2);
+
+		auto* output = reinterpret_cast<__m128i*>(destination + index);
+		_mm_storeu_si128(output, expand(a));
+		_mm_storeu_si128(output + 1, expand(_mm_alignr_epi8(b, a, 12)));
+		_mm_storeu_si128(output + 2, expand(_mm_alignr_epi8(c, b, 8)));
+		_mm_storeu_si128(output + 3, expand(_mm_srli_si128(c, 4)));
+	}
+#endif
+
+	expandRgbToRgbaScalar(rgb + index * 3, destination + index, count - index);
+}
+
+
+void NAS2D::expandRgbToRgbaScalar(const uint8_t* rgb, Color* destination, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const auto* source = rgb + i * 3;
+		destination[i] = {source[0], source[1], source[2], 255};
+	}
+}
+
+
+/**
+ * Looks up 8 bit palette indices.
+ *
+ * Uses AVX2 gathers when the target supports it, processing 8 pixels at a time.
+ *
+ * \param	indices		Source palette indices.
+ * \param	palette		Array of 256 colors. Entries past the source palette should be filled.
+ * \param	destination	Array of at least count pixels.
+ * \param	count		Number of pixels.
+ */
+void NAS2D::expandPalette(const uint8_t* indices, const Color* palette, Color* destination, std::size_t count)
+{
+	std::size_t index = 0;
+
+#if defined(NAS2D_AVX2)
+	const auto* paletteValues = reinterpret_cast<const int*>(palette);
+	for (; index + 8 <= count; index += 8)
+	{
+		const auto packedIndices = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(indices + index));
+		const auto colors = _mm256_i32gather_epi32(paletteValues, _mm256_cvtepu8_epi32(packedIndices), 4);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + index), colors);
+	}
+#endif
+
+	expandPaletteScalar(indices + index, palette, destination + index, count - index);
+}
+
+
+void NAS2D::expandPaletteScalar(const uint8_t* indices, const Color* palette, Color* destination, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		destination[i] = palette[indices[i]];
+	}
+}
+
+
+/**
+ * Swaps the red and blue channels, converting BGRA byte order pixels to RGBA.
+ *
+ * Uses AVX2 or SSE2 when the target supports it. Source and destination may be the same.
+ *
+ * \param	source		Pixels in BGRA byte order.
+ * \param	destination	Array of at least count pixels.
+ * \param	count		Number of pixels.
+ */
+void NAS2D::swizzleBgraToRgba(const Color* source, Color* destination, std::size_t count)
+{
+	std::size_t index = 0;
+
+	// Within a little endian 32 bit lane, red and blue are the low bytes of each 16 bit half
+#if defined(NAS2D_AVX2)
+	const auto greenAlphaMask256 = _mm256_set1_epi32(static_cast<int>(0xFF00FF00));
+	for (; index + 8 <= count; index += 8)
+	{
+		const auto colors = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + index));
+		const auto greenAlpha = _mm256_and_si256(colors, greenAlphaMask256);
+		const auto redBlue = _mm256_andnot_si256(greenAlphaMask256, colors);
+		const auto swapped = _mm256_or_si256(_mm256_slli_epi32(redBlue, 16), _mm256_srli_epi32(redBlue, 16));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + index), _mm256_or_si256(greenAlpha, swapped));
+	}
+#endif
+
+#if defined(NAS2D_SSE2)
+	const auto greenAlphaMask = _mm_set1_epi32(static_cast<int>(0xFF00FF00));
+	for (; index + 4 <= count; index += 4)
+	{
+		const auto colors = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + index));
+		const auto greenAlpha = _mm_and_si128(colors, greenAlphaMask);
+		const auto redBlue = _mm_andnot_si128(greenAlphaMask, colors);
+		const auto swapped = _mm_or_si128(_mm_slli_epi32(redBlue, 16), _mm_srli_epi32(redBlue, 16));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + index), _mm_or_si128(greenAlpha, swapped));
+	}
+#endif
+
+	swizzleBgraToRgbaScalar(source + index, destination + index, count - index);
+}
+
+
+void NAS2D::swizzleBgraToRgbaScalar(const Color* source, Color* destination, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const auto color = source[i];
+		destination[i] = {color.blue, color.green, color.red, color.alpha};
+	}
+}
+
+
+/**
+ * Scales the color channels of each pixel by its alpha, rounding to nearest.
+ *
+ * Uses SSE2 when the target supports it, processing 4 pixels at a time.
+ */
+void NAS2D::premultiplyAlpha(Color* pixels, std::size_t count)
+{
+	std::size_t index = 0;
+
+#if defined(NAS2D_SSE2)
+	const auto zero = _mm_setzero_si128();
+	const auto alphaLanes = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+	const auto alphaOne = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+	const auto bias = _mm_set1_epi16(128);
+	const auto premultiply = [alphaLanes, alphaOne, bias](__m128i colors) {
+		// Alpha is multiplied by 255, which the division by 255 leaves unchanged
+		auto alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(colors, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		alpha = _mm_or_si128(_mm_andnot_si128(alphaLanes, alpha), alphaOne);
+		// Exact rounded division by 255: (x + 128 + ((x + 128) >> 8)) >> 8
+		const auto product = _mm_add_epi16(_mm_mullo_epi16(colors, alpha), bias);
+		return _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+	};
+
+	for (; index + 4 <= count; index += 4)
+	{
+		auto* lane = reinterpret_cast<__m128i*>(pixels + index);
+		const auto colors = _mm_loadu_si128(lane);
+		const auto low = premultiply(_mm_unpacklo_epi8(colors, zero));
+		const auto high = premultiply(_mm_unpackhi_epi8(colors, zero));
+		_mm_storeu_si128(lane, _mm_packus_epi16(low, high));
+	}
+#endif
+
+	premultiplyAlphaScalar(pixels + index, count - index);
+}
+
+
+void NAS2D::premultiplyAlphaScalar(Color* pixels, std::size_t count)
+{
+	const auto multiply = [](uint8_t value, uint8_t alpha) {
+		const auto product = unsigned{value} * alpha + 128;
+		return static_cast<uint8_t>((product + (product >> 8)) >> 8);
+	};
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		auto& color = pixels[i];
+		color = {multiply(color.red, color.alpha), multiply(color.green, color.alpha), multiply(color.blue, color.alpha), color.alpha};
+	}
+}
+
+
+/**
+ * Sets the alpha of each pixel, such as for formats with an unused padding byte.
+ */
+void NAS2D::fillAlpha(Color* pixels, std::size_t count, uint8_t alpha)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		pixels[i].alpha = alpha;
+	}
+}
+
+
+/**
+ * Whether every pixel has an alpha of 255.
+ *
+ * Uses SSE2 when the target supports it, testing 16 pixels at a time.
+ */
+bool NAS2D::allOpaque(const Color* pixels, std::size_t count)
+{
+	std::size_t index = 0;
+
+#if defined(NAS2D_SSE2)
+	const auto opaque = _mm_set1_epi8(-1);
+	// Alpha is the high byte of each 32 bit lane
+	constexpr int alphaBytes{0x8888};
+
+	for (; index + 16 <= count; index += 16)
+	{
+		const auto* lanes = reinterpret_cast<const __m128i*>(pixels + index);
+		const auto combined = _mm_and_si128(_mm_and_si128(_mm_loadu_si128(lanes), _mm_loadu_si128(lanes + 1)), _mm_and_si128(_mm_loadu_si128(lanes + 2), _mm_loadu_si128(lanes + 3)));
+		if ((_mm_movemask_epi8(_mm_cmpeq_epi8(combined, opaque)) & alphaBytes) != alphaBytes)
+		{
+			return false;
+		}
+	}
+#endif
+
+	return allOpaqueScalar(pixels + index, count - index);
+}
+
+
+bool NAS2D::allOpaqueScalar(const Color* pixels, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		if (pixels[i].alpha != 255)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+namespace
+{
+	constexpr uint8_t BayerMatrix[4][4]{
+		{0, 8, 2, 10},
+		{12, 4, 14, 6},
+		{3, 11, 1, 9},
+		{15, 7, 13, 5},
+	};
+
+
+	// Added to a channel before it is truncated to its top bits. Half a step rounds
+	// to nearest. Dither thresholds spread the rounding error over neighbouring pixels.
+	uint8_t quantizeOffset(int bits, std::optional<int> ditherRow, std::size_t x)
+	{
+		const auto step = 1 << (8 - bits);
+		const auto offset = ditherRow ? BayerMatrix[*ditherRow & 3][x & 3] * step / 16 : step / 2;
+		return static_cast<uint8_t>(offset);
+	}
+
+
+	// Offsets of 4 consecutive pixels, starting at a column that is a multiple of 4
+	std::array<Color, 4> quantizeOffsets(const std::array<int, 4>& channelBits, std::optional<int> ditherRow)
+	{
+		std::array<Color, 4> offsets;
+		for (std::size_t x = 0; x < offsets.size(); ++x)
+		{
+			offsets[x] = {
+				quantizeOffset(channelBits[0], ditherRow, x),
+				quantizeOffset(channelBits[1], ditherRow, x),
+				quantizeOffset(channelBits[2], ditherRow, x),
+				quantizeOffset(channelBits[3], ditherRow, x),
+			};
+		}
+		return offsets;
+	}
+
+
+	Color addSaturated(Color color, Color offset)
+	{
+		const auto add = [](uint8_t value, uint8_t amount) {
+			return static_cast<uint8_t>(std::min(value + amount, 255));
+		};
+		return {add(color.red, offset.red), add(color.green, offset.green), add(color.blue, offset.blue), add(color.alpha, offset.alpha)};
+	}
+
+
+	uint16_t packRgb565(Color color)
+	{
+		return static_cast<uint16_t>((color.red >> 3) << 11 | (color.green >> 2) << 5 | color.blue >> 3);
+	}
+
+
+	uint16_t packRgba4444(Color color)
+	{
+		return static_cast<uint16_t>((color.red >> 4) << 12 | (color.green >> 4) << 8 | (color.blue >> 4) << 4 | color.alpha >> 4);
+	}
+
+
+	template <typename PackFunction>
+	void quantizeScalar(const Color* source, uint16_t* destination, std::size_t startIndex, std::size_t count, const std::array<Color, 4>& offsets, PackFunction pack)
+	{
+		for (std::size_t i = startIndex; i < count; ++i)
+		{
+			destination[i] = pack(addSaturated(source[i], offsets[i & 3]));
+		}
+	}
+
+
+#if defined(NAS2D_SSE2)
+	// Quantizes 8 pixels at a time, with each 32 bit lane packed into its low 16 bits
+	template <typename PackFunction>
+	std::size_t quantizeSse2(const Color* source, uint16_t* destination, std::size_t count, const std::array<Color, 4>& offsets, PackFunction pack)
+	{
+		const auto offsetLanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(offsets.data()));
+		// Pack is signed saturating, so values are moved into signed range and back
+		const auto signedBias32 = _mm_set1_epi32(0x8000);
+		const auto signedBias16 = _mm_set1_epi16(std::numeric_limits<short>::min());
+
+		std::size_t index = 0;
+		for (; index + 8 <= count; index += 8)
+		{
+			const auto low = pack(_mm_adds_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + index)), offsetLanes));
+			const auto high = pack(_mm_adds_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + index + 4)), offsetLanes));
+			const auto packed = _mm_packs_epi32(_mm_sub_epi32(low, signedBias32), _mm_sub_epi32(high, signedBias32));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + index), _mm_sub_epi16(packed, signedBias16));
+		}
+		return index;
+	}
+#endif
+
+
+	// Averages each 2x2 block of two rows. The last column and row repeat for odd sizes.
+	void downsampleRowScalar(const Color* row0, const Color* row1, int sourceWidth, Color* destination, int startX, int destinationWidth)
+	{
+		const auto average = [](unsigned int a, unsigned int b, unsigned int c, unsigned int d) {
+			return static_cast<uint8_t>((a + b + c + d + 2) / 4);
+		};
+
+		for (int x = startX; x < destinationWidth; ++x)
+		{
+			const auto x0 = static_cast<std::size_t>(x * 2);
+			const auto x1 = static_cast<std::size_t>(std::min(x * 2 + 1, sourceWidth - 1));
+			const auto &a = row0[x0], &b = row0[x1], &c = row1[x0], &d = row1[x1];
+			destination[x] = {
+				average(a.red, b.red, c.red, d.red),
+				average(a.green, b.green, c.green, d.green),
+				average(a.blue, b.blue, c.blue, d.blue),
+				average(a.alpha, b.alpha, c.alpha, d.alpha),
+			};
+		}
+	}
+
+
+	template <typename RowFunction>
+	void downsampleRows(const Color* source, Vector<int> sourceSize, Color* destination, RowFunction rowFunction)
+	{
+		const auto destinationSize = downsampledSize(sourceSize);
+		const auto sourceWidth = static_cast<std::size_t>(sourceSize.x);
+		for (int y = 0; y < destinationSize.y; ++y)
+		{
+			const auto* row0 = source + static_cast<std::size_t>(y * 2) * sourceWidth;
+			const auto* row1 = source + static_cast<std::size_t>(std::min(y * 2 + 1, sourceSize.y - 1)) * sourceWidth;
+			rowFunction(row0, row1, destination + static_cast<std::size_t>(y) * static_cast<std::size_t>(destinationSize.x), destinationSize.x);
+		}
+	}
+}
+
+
+/**
+ * Reduces a row of pixels to 16 bit RGB 565, for GL_UNSIGNED_SHORT_5_6_5. Alpha is dropped.
+ *
+ * Uses SSE2 when the target supports it, processing 8 pixels at a time.
+ *
+ * \param	source		Row of pixels, starting at the first column of the image.
+ * \param	destination	Array of at least count values.
+ * \param	count		Number of pixels.
+ * \param	ditherRow	Image row, to apply a 4x4 ordered dither for that row. Without
+ *						it, channels are rounded to nearest.
+ */
+void NAS2D::quantizeRgb565(const Color* source, uint16_t* destination, std::size_t count, std::optional<int> ditherRow)
+{
+	const auto offsets = quantizeOffsets({5, 6, 5, 8}, ditherRow);
+	std::size_t index = 0;
+
+#if defined(NAS2D_SSE2)
+	const auto redMask = _mm_set1_epi32(0xF8);
+	const auto greenMask = _mm_set1_epi32(0xFC00);
+	const auto blueMask = _mm_set1_epi32(0xF80000);
+	index = quantizeSse2(source, destination, count, offsets, [redMask, greenMask, blueMask](__m128i colors) {
+		const auto red = _mm_slli_epi32(_mm_and_si128(colors, redMask), 8);
+		const auto green = _mm_srli_epi32(_mm_and_si128(colors, greenMask), 5);
+		const auto blue = _mm_srli_epi32(_mm_and_si128(colors, blueMask), 19);
+		return _mm_or_si128(_mm_or_si128(red, green), blue);
+	});
+#endif
+
+	quantizeScalar(source, destination, index, count, offsets, packRgb565);
+}
+
+
+void NAS2D::quantizeRgb565Scalar(const Color* source, uint16_t* destination, std::size_t count, std::optional<int> ditherRow)
+{
+	quantizeScalar(source, destination, 0, count, quantizeOffsets({5, 6, 5, 8}, ditherRow), packRgb565);
+}
+
+
+/**
+ * Reduces a row of pixels to 16 bit RGBA 4444, for GL_UNSIGNED_SHORT_4_4_4_4.
+ *
+ * Uses SSE2 when the target supports it, processing 8 pixels at a time.
+ *
+ * \param	source		Row of pixels, starting at the first column of the image.
+ * \param	destination	Array of at least count values.
+ * \param	count		Number of pixels.
+ * \param	ditherRow	Image row, to apply a 4x4 ordered dither for that row. Without
+ *						it, channels are rounded to nearest.
+ */
+void NAS2D::quantizeRgba4444(const Color* source, uint16_t* destination, std::size_t count, std::optional<int> ditherRow)
+{
+	const auto offsets = quantizeOffsets({4, 4, 4, 4}, ditherRow);
+	std::size_t index = 0;
+
+#if defined(NAS2D_SSE2)
+	const auto redMask = _mm_set1_epi32(0xF0);
+	const auto greenMask = _mm_set1_epi32(0xF000);
+	const auto blueMask = _mm_set1_epi32(0xF00000);
+	index = quantizeSse2(source, destination, count, offsets, [redMask, greenMask, blueMask](__m128i colors) {
+		const auto red = _mm_slli_epi32(_mm_and_si128(colors, redMask), 8);
+		const auto green = _mm_srli_epi32(_mm_and_si128(colors, greenMask), 4);
+		const auto blue = _mm_srli_epi32(_mm_and_si128(colors, blueMask), 16);
+		const auto alpha = _mm_srli_epi32(colors, 28);
+		return _mm_or_si128(_mm_or_si128(red, green), _mm_or_si128(blue, alpha));
+	});
+#endif
+
+	quantizeScalar(source, destination, index, count, offsets, packRgba4444);
+}
+
+
+void NAS2D::quantizeRgba4444Scalar(const Color* source, uint16_t* destination, std::size_t count, std::optional<int> ditherRow)
+{
+	quantizeScalar(source, destination, 0, count, quantizeOffsets({4, 4, 4, 4}, ditherRow), packRgba4444);
+}
+
+
+/**
+ * Packs whether each value is above a threshold into bits, least significant bit first.
+ *
+ * Uses SSE2 when the target supports it, processing 64 values at a time.
+ *
+ * \param	values		Values to compare, such as the alpha channel from extractChannel().
+ * \param	destination	Array of at least (count + 63) / 64 words. Bits past count are cleared.
+ * \param	count		Number of values.
+ * \param	threshold	Largest value that gives a clear bit.
+ */
+void NAS2D::packThresholdBits(const uint8_t* values, uint64_t* destination, std::size_t count, uint8_t threshold)
+{
+	std::size_t index = 0;
+
+#if defined(NAS2D_SSE2)
+	const auto thresholdLanes = _mm_set1_epi8(static_cast<char>(threshold));
+	const auto zero = _mm_setzero_si128();
+	const auto aboveBits = [values, thresholdLanes, zero](std::size_t offset) {
+		const auto lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + offset));
+		// Saturating subtraction leaves zero for values at or below the threshold
+		const auto atOrBelow = _mm_cmpeq_epi8(_mm_subs_epu8(lanes, thresholdLanes), zero);
+		return static_cast<uint64_t>(~_mm_movemask_epi8(atOrBelow) & 0xFFFF);
+	};
+
+	for (; index + 64 <= count; index += 64)
+	{
+		destination[index / 64] = aboveBits(index) | aboveBits(index + 16) << 16 | aboveBits(index + 32) << 32 | aboveBits(index + 48) << 48;
+	}
+#endif
+
+	packThresholdBitsScalar(values + index, destination + index / 64, count - index, threshold);
+}
+
+
+void NAS2D::packThresholdBitsScalar(const uint8_t* values, uint64_t* destination, std::size_t count, uint8_t threshold)
+{
+	for (std::size_t word = 0; word * 64 < count; ++word)
+	{
+		uint64_t bits = 0;
+		for (std::size_t bit = 0; bit < 64 && word * 64 + bit < count; ++bit)
+		{
+			if (values[word * 64 + bit] > threshold)
+			{
+				bits |= uint64_t{1} << bit;
+			}
+		}
+		destination[word] = bits;
+	}
+}
+
+
+/**
+ * Whether any bit is set both in a row of bits, and in another row shifted towards higher bits.
+ *
+ * Uses SSE2 when the target supports it, processing 2 words at a time.
+ *
+ * \param	bits		Words to test.
+ * \param	shiftedBits	Words to shift, starting one word early. Word i of bits is
+ *						tested against word i + 1 shifted left, with the high bits
+ *						of word i carried in. Needs count + 1 words.
+ * \param	count		Number of words in bits.
+ * \param	bitShift	Shift from 0 to 63.
+ */
+bool NAS2D::anyBitsOverlap(const uint64_t* bits, const uint64_t* shiftedBits, std::size_t count, unsigned int bitShift)
+{
+	std::size_t index = 0;
+
+#if defined(NAS2D_SSE2)
+	const auto zero = _mm_setzero_si128();
+	// Shifting a 64 bit lane by 64 clears it, which handles a shift of 0
+	const auto leftShift = _mm_cvtsi32_si128(static_cast<int>(bitShift));
+	const auto rightShift = _mm_cvtsi32_si128(static_cast<int>(64 - bitShift));
+
+	for (; index + 2 <= count; index += 2)
+	{
+		const auto current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shiftedBits + index + 1));
+		const auto previous = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shiftedBits + index));
+		const auto shifted = _mm_or_si128(_mm_sll_epi64(current, leftShift), _mm_srl_epi64(previous, rightShift));
+		const auto both = _mm_and_si128(shifted, _mm_loadu_si128(reinterpret_cast<const __m128i*>(bits + index)));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(both, zero)) != 0xFFFF)
+		{
+			return true;
+		}
+	}
+#endif
+
+	return anyBitsOverlapScalar(bits + index, shiftedBits + index, count - index, bitShift);
+}
+
+
+bool NAS2D::anyBitsOverlapScalar(const uint64_t* bits, const uint64_t* shiftedBits, std::size_t count, unsigned int bitShift)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const auto carried = bitShift == 0 ? 0 : shiftedBits[i] >> (64 - bitShift);
+		if (bits[i] & ((shiftedBits[i + 1] << bitShift) | carried))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+/**
+ * Size of the next smaller mipmap level: half the size, rounded down, but at least 1.
+ */
+Vector<int> NAS2D::downsampledSize(Vector<int> size)
+{
+	return {std::max(size.x / 2, 1), std::max(size.y / 2, 1)};
+}
+
+
+/**
+ * Halves the size of an image with a 2x2 box filter, as for the next mipmap level.
+ *
+ * Uses SSE2 when the target supports it, producing 2 pixels at a time.
+ *
+ * \param	source		Tightly packed rows of pixels.
+ * \param	sourceSize	Size of the source image.
+ * \param	destination	Array of at least downsampledSize(sourceSize) pixels.
+ */
+void NAS2D::downsample2x(const Color* source, Vector<int> sourceSize, Color* destination)
+{
+#if defined(NAS2D_SSE2)
+	downsampleRows(source, sourceSize, destination, [sourceWidth = sourceSize.x](const Color* row0, const Color* row1, Color* destinationRow, int destinationWidth) {
+		const auto zero = _mm_setzero_si128();
+		const auto bias = _mm_set1_epi16(2);
+
+		int x = 0;
+		// Each step reads 4 source pixels from each row
+		for (; x * 2 + 4 <= sourceWidth && x + 2 <= destinationWidth; x += 2)
+		{
+			const auto top = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 2));
+			const auto bottom = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 2));
+			// Vertical sums of pixel pairs 0, 1 and 2, 3, as 16 bit channels
+			const auto left = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+			const auto right = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+			// Add horizontal neighbours, which are the two 64 bit halves of each sum
+			const auto leftSum = _mm_add_epi16(left, _mm_srli_si128(left, 8));
+			const auto rightSum = _mm_add_epi16(right, _mm_srli_si128(right, 8));
+			const auto sums = _mm_unpacklo_epi64(leftSum, rightSum);
+			const auto averages = _mm_srli_epi16(_mm_add_epi16(sums, bias), 2);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(destinationRow + x), _mm_packus_epi16(averages, zero));
+		}
+
+		downsampleRowScalar(row0, row1, sourceWidth, destinationRow, x, destinationWidth);
+	});
+#else
+	downsample2xScalar(source, sourceSize, destination);
+#endif
+}
+
+
+void NAS2D::downsample2xScalar(const Color* source, Vector<int> sourceSize, Color* destination)
+{
+	downsampleRows(source, sourceSize, destination, [sourceWidth = sourceSize.x](const Color* row0, const Color* row1, Color* destinationRow, int destinationWidth) {
+		downsampleRowScalar(row0, row1, sourceWidth, destinationRow, 0, destinationWidth);
+	});
+}
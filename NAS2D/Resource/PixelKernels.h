@@ -0,0 +1,67 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include "../Renderer/Color.h"
+#include "../Math/Vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+
+namespace NAS2D
+{
+	enum class ColorChannel
+	{
+		Red,
+		Green,
+		Blue,
+		Alpha,
+	};
+
+
+	void extractChannel(const Color* pixels, uint8_t* destination, std::size_t count, ColorChannel channel);
+	void extractChannelScalar(const Color* pixels, uint8_t* destination, std::size_t count, ColorChannel channel);
+
+	void expandRgbToRgba(const uint8_t* rgb, Color* destination, std::size_t count);
+	void expandRgbToRgbaScalar(const uint8_t* rgb, Color* destination, std::size_t count);
+
+	void expandPalette(const uint8_t* indices, const Color* palette, Color* destination, std::size_t count);
+	void expandPaletteScalar(const uint8_t* indices, const Color* palette, Color* destination, std::size_t count);
+
+	void swizzleBgraToRgba(const Color* source, Color* destination, std::size_t count);
+	void swizzleBgraToRgbaScalar(const Color* source, Color* destination, std::size_t count);
+
+	void premultiplyAlpha(Color* pixels, std::size_t count);
+	void premultiplyAlphaScalar(Color* pixels, std::size_t count);
+
+	void fillAlpha(Color* pixels, std::size_t count, uint8_t alpha);
+
+	bool allOpaque(const Color* pixels, std::size_t count);
+	bool allOpaqueScalar(const Color* pixels, std::size_t count);
+
+	void quantizeRgb565(const Color* source, uint16_t* destination, std::size_t count, std::optional<int> ditherRow);
+	void quantizeRgb565Scalar(const Color* source, uint16_t* destination, std::size_t count, std::optional<int> ditherRow);
+
+	void quantizeRgba4444(const Color* source, uint16_t* destination, std::size_t count, std::optional<int> ditherRow);
+	void quantizeRgba4444Scalar(const Color* source, uint16_t* destination, std::size_t count, std::optional<int> ditherRow);
+
+	void packThresholdBits(const uint8_t* values, uint64_t* destination, std::size_t count, uint8_t threshold);
+	void packThresholdBitsScalar(const uint8_t* values, uint64_t* destination, std::size_t count, uint8_t threshold);
+
+	bool anyBitsOverlap(const uint64_t* bits, const uint64_t* shiftedBits, std::size_t count, unsigned int bitShift);
+	bool anyBitsOverlapScalar(const uint64_t* bits, const uint64_t* shiftedBits, std::size_t count, unsigned int bitShift);
+
+	Vector<int> downsampledSize(Vector<int> size);
+	void downsample2x(const Color* source, Vector<int> sourceSize, Color* destination);
+	void downsample2xScalar(const Color* source, Vector<int> sourceSize, Color* destination);
+}
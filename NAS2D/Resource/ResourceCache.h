@@ -10,18 +10,32 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
 #include <tuple>
+#include <utility>
 
 
 namespace NAS2D
 {
 
+	/**
+	 * Cache of resources, keyed on their constructor parameters.
+	 *
+	 * Optionally, resources with identical content can be shared between keys,
+	 * see shareIdenticalContent().
+	 */
 	template <typename Resource, typename... Params>
 	class ResourceCache
 	{
 	public:
 		using Key = std::tuple<Params...>;
+		using HashFunction = std::function<uint64_t(const Params&...)>;
+		using SizeFunction = std::function<std::size_t(const Resource&)>;
+		using EqualFunction = std::function<bool(const Key&, const Key&)>;
 
 
 		const Resource& load(Params... params)
@@ -33,13 +47,12 @@ namespace NAS2D
 			auto iter = cache.find(key);
 			if (iter == cache.end())
 			{
-				// Resource wasn't found, so create new one using constructor parameters
-				const auto pairIterBool = cache.try_emplace(key, params...);
-				iter = pairIterBool.first;
+				// Resource wasn't found, so share one with the same content, or create new one using constructor parameters
+				iter = cache.try_emplace(key, sharedOrNew(key, params...)).first;
 			}
 
 			// Return reference to found or created cached object
-			return iter->second;
+			return *iter->second;
 		}
 
 
@@ -52,6 +65,7 @@ namespace NAS2D
 		void clear()
 		{
 			cache.clear();
+			contentCache.clear();
 		}
 
 
@@ -60,8 +74,90 @@ namespace NAS2D
 			return cache.size();
 		}
 
+
+		/**
+		 * Shares one resource between keys whose content is identical.
+		 *
+		 * The hash is computed before each new resource is constructed, such as
+		 * from the file contents. Keys with equal hashes are then compared with
+		 * the equality function, so a hash collision doesn't share different
+		 * content. Shared resources are freed when the last key referring to
+		 * them is unloaded.
+		 *
+		 * \param	hashFunction	Hash of the content the parameters would load.
+		 * \param	sizeFunction	Memory used by a resource, for sharedBytes().
+		 * \param	equalFunction	Whether two keys would load identical content. Without it, equal hashes are trusted.
+		 */
+		void shareIdenticalContent(HashFunction hashFunction, SizeFunction sizeFunction = {}, EqualFunction equalFunction = {})
+		{
+			contentHash = std::move(hashFunction);
+			resourceSize = std::move(sizeFunction);
+			contentEqual = std::move(equalFunction);
+		}
+
+
+		/**
+		 * Number of loads that shared an existing resource instead of creating one.
+		 */
+		std::size_t sharedCount() const
+		{
+			return sharedLoads;
+		}
+
+
+		/**
+		 * Memory that loads sharing an existing resource would otherwise have used.
+		 */
+		std::size_t sharedBytes() const
+		{
+			return sharedLoadBytes;
+		}
+
 	private:
-		std::map<Key, Resource> cache{};
+		struct ContentEntry
+		{
+			Key key;
+			std::weak_ptr<Resource> resource;
+		};
+
+
+		std::shared_ptr<Resource> sharedOrNew(const Key& key, const Params&... params)
+		{
+			if (!contentHash)
+			{
+				return std::make_shared<Resource>(params...);
+			}
+
+			const auto hash = contentHash(params...);
+			const auto [begin, end] = contentCache.equal_range(hash);
+			for (auto iter = begin; iter != end; ++iter)
+			{
+				const auto& entry = iter->second;
+				auto resource = entry.resource.lock();
+				if (resource && (!contentEqual || contentEqual(entry.key, key)))
+				{
+					++sharedLoads;
+					sharedLoadBytes += resourceSize ? resourceSize(*resource) : 0;
+					return resource;
+				}
+			}
+
+			auto resource = std::make_shared<Resource>(params...);
+			// Entries of unloaded resources would otherwise pile up
+			std::erase_if(contentCache, [](const auto& item) { return item.second.resource.expired(); });
+			contentCache.emplace(hash, ContentEntry{key, resource});
+			return resource;
+		}
+
+
+		std::map<Key, std::shared_ptr<Resource>> cache{};
+
+		HashFunction contentHash{};
+		SizeFunction resourceSize{};
+		EqualFunction contentEqual{};
+		std::multimap<uint64_t, ContentEntry> contentCache{};
+		std::size_t sharedLoads{0};
+		std::size_t sharedLoadBytes{0};
 	};
 
 } // namespace
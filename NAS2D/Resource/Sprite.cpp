@@ -113,6 +113,12 @@ void Sprite::setFrame(std::size_t frameIndex)
 }
 
 
+const AnimationSet::Frame& Sprite::currentFrame() const
+{
+	return (*mCurrentAction)[mCurrentFrame];
+}
+
+
 void Sprite::update()
 {
 	mTimer.adjustStartTick(advanceByTimeDelta(mTimer.elapsedTicks()));
@@ -122,9 +128,21 @@ void Sprite::update()
 void Sprite::draw(Point<float> position) const
 {
 	const auto& frame = (*mCurrentAction)[mCurrentFrame];
+	auto& renderer = Utility<Renderer>::get();
+
+	// Rotation is about the center of the full frame, so only unrotated frames skip transparent margins
+	if (mRotationAngleDegrees == 0.0f)
+	{
+		if (!frame.opaqueBounds.empty())
+		{
+			renderer.drawSubImage(frame.image, position - frame.opaqueAnchorOffset.to<float>(), frame.opaqueBounds.to<float>(), mTintColor);
+		}
+		return;
+	}
+
 	const auto drawPosition = position - frame.anchorOffset.to<float>();
 	const auto frameBounds = frame.bounds.to<float>();
-	Utility<Renderer>::get().drawSubImageRotated(frame.image, drawPosition, frameBounds, mRotationAngleDegrees, mTintColor);
+	renderer.drawSubImageRotated(frame.image, drawPosition, frameBounds, mRotationAngleDegrees, mTintColor);
 }
 
 
@@ -49,6 +49,7 @@ namespace NAS2D
 		void resume();
 
 		void setFrame(std::size_t frameIndex);
+		const AnimationSet::Frame& currentFrame() const;
 
 		void update();
 		void draw(Point<float> position) const;
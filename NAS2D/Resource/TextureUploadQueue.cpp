@@ -0,0 +1,181 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "TextureUploadQueue.h"
+
+#include "Image.h"
+
+#if defined(__XCODE_BUILD__)
+#include <GLEW/GLEW.h>
+#else
+#include <GL/glew.h>
+#endif
+
+#include <algorithm>
+
+
+using namespace NAS2D;
+
+
+/**
+ * \param	byteBudget	Bytes of pixel data to upload per frame.
+ * \param	timeBudget	Time to spend uploading per frame.
+ */
+TextureUploadQueue::TextureUploadQueue(std::size_t byteBudget, std::chrono::microseconds timeBudget) :
+	mByteBudget{byteBudget},
+	mTimeBudget{timeBudget}
+{
+}
+
+
+TextureUploadQueue::~TextureUploadQueue()
+{
+	for (const auto* image : mPending)
+	{
+		image->mUploadQueue = nullptr;
+	}
+
+	if (mPixelBufferId != 0)
+	{
+		glDeleteBuffers(1, &mPixelBufferId);
+	}
+}
+
+
+/**
+ * Queues an image for upload. Images already uploaded or queued are ignored,
+ * as are tiled images, whose tiles are uploaded as they are drawn.
+ */
+void TextureUploadQueue::push(const Image& image)
+{
+	if (image.isUploaded() || image.isTiled() || std::find(mPending.begin(), mPending.end(), &image) != mPending.end())
+	{
+		return;
+	}
+	mPending.push_back(&image);
+	image.mUploadQueue = this;
+}
+
+
+/**
+ * Removes an image from the queue, such as before it is destroyed.
+ */
+void TextureUploadQueue::cancel(const Image& image)
+{
+	if (image.mUploadQueue == this)
+	{
+		image.mUploadQueue = nullptr;
+	}
+	mPending.erase(std::remove(mPending.begin(), mPending.end(), &image), mPending.end());
+}
+
+
+/**
+ * Uploads queued images until the frame budget is used. Call once per frame.
+ */
+void TextureUploadQueue::update()
+{
+	using Clock = std::chrono::steady_clock;
+
+	if (mPending.empty())
+	{
+		return;
+	}
+
+	++mStats.frames;
+	const auto startTime = Clock::now();
+	std::size_t frameBytes = 0;
+
+	while (!mPending.empty())
+	{
+		const auto& image = *mPending.front();
+		const auto overBudget = frameBytes + image.uploadByteCount() > mByteBudget || Clock::now() - startTime >= mTimeBudget;
+		if (frameBytes > 0 && overBudget)
+		{
+			break;
+		}
+
+		mPending.pop_front();
+		frameBytes += upload(image);
+	}
+
+	if (frameBytes > mByteBudget || Clock::now() - startTime > mTimeBudget)
+	{
+		++mStats.framesOverBudget;
+	}
+}
+
+
+/**
+ * Uploads all queued images now, ignoring the budget. Useful behind a loading screen.
+ */
+void TextureUploadQueue::flush()
+{
+	while (!mPending.empty())
+	{
+		const auto& image = *mPending.front();
+		mPending.pop_front();
+		upload(image);
+	}
+}
+
+
+bool TextureUploadQueue::empty() const
+{
+	return mPending.empty();
+}
+
+
+std::size_t TextureUploadQueue::size() const
+{
+	return mPending.size();
+}
+
+
+const TextureUploadQueue::Stats& TextureUploadQueue::stats() const
+{
+	return mStats;
+}
+
+
+std::size_t TextureUploadQueue::upload(const Image& image)
+{
+	// Out of the queue before uploading, so the upload doesn't cancel it
+	if (image.mUploadQueue == this)
+	{
+		image.mUploadQueue = nullptr;
+	}
+
+	// Image may have been drawn, and so uploaded, since it was queued
+	if (image.isUploaded())
+	{
+		return 0;
+	}
+
+	const auto byteCount = image.uploadByteCount();
+
+	if (mPixelBufferId == 0 && (GLEW_VERSION_2_1 || GLEW_ARB_pixel_buffer_object))
+	{
+		glGenBuffers(1, &mPixelBufferId);
+	}
+
+	if (mPixelBufferId != 0)
+	{
+		image.uploadStreamed(mPixelBufferId);
+	}
+	else
+	{
+		image.upload();
+	}
+
+	++mStats.texturesUploaded;
+	mStats.bytesUploaded += byteCount;
+	return byteCount;
+}
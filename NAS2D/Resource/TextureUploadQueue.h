@@ -0,0 +1,73 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+
+
+namespace NAS2D
+{
+	class Image;
+
+
+	/**
+	 * Spreads texture uploads across frames.
+	 *
+	 * Images are queued ahead of when they are first drawn, and update() uploads
+	 * as many as fit in the per frame byte and time budgets. At least one image
+	 * is uploaded per frame, so images larger than the budget still progress.
+	 *
+	 * Pixels are streamed through a pixel buffer object when supported.
+	 *
+	 * Images destroyed while queued remove themselves from the queue.
+	 */
+	class TextureUploadQueue
+	{
+	public:
+		struct Stats
+		{
+			std::size_t frames{0}; // Frames that started with uploads pending
+			std::size_t framesOverBudget{0};
+			std::size_t texturesUploaded{0};
+			std::size_t bytesUploaded{0};
+		};
+
+		static constexpr std::size_t DefaultByteBudget{4 * 1024 * 1024};
+		static constexpr std::chrono::microseconds DefaultTimeBudget{2000};
+
+		TextureUploadQueue(std::size_t byteBudget = DefaultByteBudget, std::chrono::microseconds timeBudget = DefaultTimeBudget);
+		TextureUploadQueue(const TextureUploadQueue&) = delete;
+		TextureUploadQueue& operator=(const TextureUploadQueue&) = delete;
+		~TextureUploadQueue();
+
+		void push(const Image& image);
+		void cancel(const Image& image);
+
+		void update();
+		void flush();
+
+		bool empty() const;
+		std::size_t size() const;
+
+		const Stats& stats() const;
+
+	private:
+		std::size_t upload(const Image& image);
+
+		std::size_t mByteBudget;
+		std::chrono::microseconds mTimeBudget;
+		std::deque<const Image*> mPending{};
+		unsigned int mPixelBufferId{0};
+		Stats mStats{};
+	};
+} // namespace NAS2D
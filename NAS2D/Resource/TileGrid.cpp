@@ -0,0 +1,102 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+
+#include "TileGrid.h"
+
+#include <algorithm>
+
+
+using namespace NAS2D;
+
+
+/**
+ * Whether an image is too large for a single texture.
+ *
+ * \param	imageSize		Size of the image in pixels.
+ * \param	maxTextureSize	Largest texture width and height, or 0 if unknown, in which case no image is tiled.
+ */
+bool TileGrid::needsTiling(Vector<int> imageSize, int maxTextureSize)
+{
+	return maxTextureSize > 0 && (imageSize.x > maxTextureSize || imageSize.y > maxTextureSize);
+}
+
+
+/**
+ * Reduces a tile size so a tile and its border fit in the largest texture.
+ *
+ * \param	tileSize		Requested width and height of tiles.
+ * \param	maxTextureSize	Largest texture width and height, or 0 if unknown.
+ */
+int TileGrid::fittedTileSize(int tileSize, int maxTextureSize)
+{
+	const auto maxTileSize = maxTextureSize > 0 ? maxTextureSize - 2 * Border : tileSize;
+	return std::max(1, std::min(tileSize, maxTileSize));
+}
+
+
+TileGrid::TileGrid(Vector<int> imageSize, int tileSize) :
+	mImageSize{imageSize},
+	mTileSize{tileSize}
+{
+}
+
+
+Vector<int> TileGrid::imageSize() const
+{
+	return mImageSize;
+}
+
+
+int TileGrid::tileSize() const
+{
+	return mTileSize;
+}
+
+
+Vector<int> TileGrid::tileCount() const
+{
+	return {(mImageSize.x + mTileSize - 1) / mTileSize, (mImageSize.y + mTileSize - 1) / mTileSize};
+}
+
+
+/**
+ * Area of the image drawn from a tile.
+ */
+Rectangle<int> TileGrid::tileBounds(Point<int> tileIndex) const
+{
+	const auto position = Point{tileIndex.x * mTileSize, tileIndex.y * mTileSize};
+	return {position, {std::min(mTileSize, mImageSize.x - position.x), std::min(mTileSize, mImageSize.y - position.y)}};
+}
+
+
+/**
+ * Area of the image held by the texture of a tile, which includes the border around the tile.
+ *
+ * Tiles along the edges of the image have no border on that side.
+ */
+Rectangle<int> TileGrid::textureBounds(Point<int> tileIndex) const
+{
+	const auto bounds = tileBounds(tileIndex);
+	const auto start = Point{std::max(bounds.position.x - Border, 0), std::max(bounds.position.y - Border, 0)};
+	const auto end = Point{std::min(bounds.endPoint().x + Border, mImageSize.x), std::min(bounds.endPoint().y + Border, mImageSize.y)};
+	return Rectangle<int>::Create(start, end);
+}
+
+
+/**
+ * Texture coordinates of the tile bounds within the texture of a tile.
+ */
+Rectangle<float> TileGrid::uvRect(Point<int> tileIndex) const
+{
+	const auto bounds = tileBounds(tileIndex);
+	const auto textureRect = textureBounds(tileIndex);
+	return Rectangle{Point{0.0f, 0.0f} + (bounds.position - textureRect.position).to<float>(), bounds.size.to<float>()}.skewInverseBy(textureRect.size.to<float>());
+}
@@ -0,0 +1,51 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+
+#pragma once
+
+#include "../Math/Point.h"
+#include "../Math/Rectangle.h"
+#include "../Math/Vector.h"
+
+
+namespace NAS2D
+{
+	/**
+	 * Layout of the tiles of a TiledTexture.
+	 *
+	 * Splits an image into square tiles, with smaller tiles along the right and
+	 * bottom edges when the image size isn't a multiple of the tile size. The
+	 * texture of each tile includes a border of pixels from its neighbours.
+	 */
+	class TileGrid
+	{
+	public:
+		// Pixels shared with each neighbouring tile, for linear filtering across tile edges
+		static constexpr int Border{1};
+
+		static bool needsTiling(Vector<int> imageSize, int maxTextureSize);
+		static int fittedTileSize(int tileSize, int maxTextureSize);
+
+		TileGrid(Vector<int> imageSize, int tileSize);
+
+		Vector<int> imageSize() const;
+		int tileSize() const;
+		Vector<int> tileCount() const;
+
+		Rectangle<int> tileBounds(Point<int> tileIndex) const;
+		Rectangle<int> textureBounds(Point<int> tileIndex) const;
+		Rectangle<float> uvRect(Point<int> tileIndex) const;
+
+	private:
+		Vector<int> mImageSize;
+		int mTileSize;
+	};
+} // namespace
@@ -0,0 +1,185 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "TiledTexture.h"
+
+#if defined(__XCODE_BUILD__)
+#include <GLEW/GLEW.h>
+#else
+#include <GL/glew.h>
+#endif
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+
+using namespace NAS2D;
+
+
+namespace
+{
+	std::uint64_t nextTiledTextureId{0};
+}
+
+
+/**
+ * Largest texture width and height supported by the driver, or 0 without a GL context.
+ */
+int TiledTexture::maxTextureSize()
+{
+	static GLint maxSize{0};
+	if (maxSize == 0)
+	{
+		glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+	}
+	return maxSize;
+}
+
+
+/**
+ * Sets the texture memory shared by the tiles of all tiled textures.
+ *
+ * Least recently drawn tiles are deleted to fit the new budget.
+ */
+void TiledTexture::setMemoryBudget(std::size_t bytes)
+{
+	tileCache().capacity(bytes);
+}
+
+
+std::size_t TiledTexture::memoryBudget()
+{
+	return tileCache().capacity();
+}
+
+
+/**
+ * Texture memory used by uploaded tiles.
+ */
+std::size_t TiledTexture::residentBytes()
+{
+	return tileCache().usage();
+}
+
+
+/**
+ * \param	size		Size of the image in pixels.
+ * \param	loader		Fills tightly packed RGBA pixels of an area of the image.
+ * \param	tileSize	Width and height of tiles. Reduced if the driver can't fit it in a texture.
+ */
+TiledTexture::TiledTexture(Vector<int> size, TileLoader loader, int tileSize) :
+	mId{++nextTiledTextureId},
+	mGrid{size, TileGrid::fittedTileSize(tileSize, maxTextureSize())},
+	mLoader{std::move(loader)}
+{
+}
+
+
+TiledTexture::~TiledTexture()
+{
+	tileCache().eraseIf([id = mId](const TileKey& key) { return key.owner == id; });
+}
+
+
+Vector<int> TiledTexture::size() const
+{
+	return mGrid.imageSize();
+}
+
+
+int TiledTexture::tileSize() const
+{
+	return mGrid.tileSize();
+}
+
+
+Vector<int> TiledTexture::tileCount() const
+{
+	return mGrid.tileCount();
+}
+
+
+/**
+ * Calls a function for each tile overlapping an area of the image, in row order.
+ *
+ * Tiles are uploaded as needed. Textures of earlier tiles may be evicted by
+ * later uploads in the same call, so draw each tile from within the function.
+ *
+ * \param	region		Area of the image in pixels.
+ * \param	function	Called with the bounds of the tile in the image, and
+ *						the texture coordinates of those bounds in its texture.
+ */
+void TiledTexture::forEachTile(const Rectangle<int>& region, const std::function<void(const Tile&)>& function)
+{
+	const auto size = mGrid.imageSize();
+	const auto tileSize = mGrid.tileSize();
+	const auto start = Point{std::max(region.position.x, 0), std::max(region.position.y, 0)};
+	const auto end = Point{std::min(region.endPoint().x, size.x), std::min(region.endPoint().y, size.y)};
+	if (!(start < end))
+	{
+		return;
+	}
+
+	for (int y = start.y / tileSize; y <= (end.y - 1) / tileSize; ++y)
+	{
+		for (int x = start.x / tileSize; x <= (end.x - 1) / tileSize; ++x)
+		{
+			const auto tileIndex = Point{x, y};
+			function(Tile{mGrid.tileBounds(tileIndex), mGrid.uvRect(tileIndex), residentTexture(tileIndex)});
+		}
+	}
+}
+
+
+TiledTexture::TileTexture::TileTexture(unsigned int textureId) :
+	mTextureId{textureId}
+{
+}
+
+
+TiledTexture::TileTexture::~TileTexture()
+{
+	glDeleteTextures(1, &mTextureId);
+}
+
+
+LruCache<TiledTexture::TileKey, TiledTexture::TileTexture>& TiledTexture::tileCache()
+{
+	static LruCache<TileKey, TileTexture> cache{DefaultMemoryBudget};
+	return cache;
+}
+
+
+unsigned int TiledTexture::residentTexture(Point<int> tileIndex)
+{
+	const auto key = TileKey{mId, tileIndex.x, tileIndex.y};
+	if (const auto* tile = tileCache().find(key))
+	{
+		return tile->id();
+	}
+
+	const auto textureRect = mGrid.textureBounds(tileIndex);
+	const auto pixelCount = textureRect.size.to<std::size_t>();
+	std::vector<Color> pixels(pixelCount.x * pixelCount.y);
+	mLoader(textureRect, pixels);
+
+	GLuint textureId;
+	glGenTextures(1, &textureId);
+	glBindTexture(GL_TEXTURE_2D, textureId);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, textureRect.size.x, textureRect.size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+	return tileCache().emplace(key, pixels.size() * sizeof(Color), textureId).id();
+}
@@ -0,0 +1,103 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include "LruCache.h"
+#include "TileGrid.h"
+
+#include "../Renderer/Color.h"
+#include "../Math/Point.h"
+#include "../Math/Rectangle.h"
+#include "../Math/Vector.h"
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+
+
+namespace NAS2D
+{
+	/**
+	 * Grid of texture tiles for an image too large to fit in a single texture.
+	 *
+	 * Tiles are uploaded the first time they are drawn. Tiles of all tiled
+	 * textures share one memory budget, and the least recently drawn tiles are
+	 * deleted when it is exceeded. Deleted tiles are loaded again when next drawn.
+	 *
+	 * Tile textures overlap their neighbours by a pixel, so linear filtering
+	 * doesn't show seams along tile edges.
+	 */
+	class TiledTexture
+	{
+	public:
+		using TileLoader = std::function<void(const Rectangle<int>& rect, std::span<Color> pixels)>;
+
+		struct Tile
+		{
+			Rectangle<int> bounds;
+			Rectangle<float> uvRect;
+			unsigned int textureId;
+		};
+
+		static constexpr int DefaultTileSize{1024};
+		static constexpr std::size_t DefaultMemoryBudget{256 * 1024 * 1024};
+
+		static int maxTextureSize();
+		static void setMemoryBudget(std::size_t bytes);
+		static std::size_t memoryBudget();
+		static std::size_t residentBytes();
+
+		TiledTexture(Vector<int> size, TileLoader loader, int tileSize = DefaultTileSize);
+		TiledTexture(const TiledTexture&) = delete;
+		TiledTexture& operator=(const TiledTexture&) = delete;
+		~TiledTexture();
+
+		Vector<int> size() const;
+		int tileSize() const;
+		Vector<int> tileCount() const;
+
+		void forEachTile(const Rectangle<int>& region, const std::function<void(const Tile&)>& function);
+
+	private:
+		struct TileKey
+		{
+			std::uint64_t owner;
+			int x;
+			int y;
+
+			auto operator<=>(const TileKey&) const = default;
+		};
+
+		class TileTexture
+		{
+		public:
+			explicit TileTexture(unsigned int textureId);
+			TileTexture(const TileTexture&) = delete;
+			TileTexture& operator=(const TileTexture&) = delete;
+			~TileTexture();
+
+			unsigned int id() const { return mTextureId; }
+
+		private:
+			unsigned int mTextureId;
+		};
+
+		static LruCache<TileKey, TileTexture>& tileCache();
+
+		unsigned int residentTexture(Point<int> tileIndex);
+
+		std::uint64_t mId;
+		TileGrid mGrid;
+		TileLoader mLoader;
+	};
+} // namespace
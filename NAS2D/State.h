@@ -42,6 +42,14 @@ namespace NAS2D
 	 * Updates to the State are done once every frame via the \c update() function. Updates
 	 * include logic, drawing, event handling, state changes, etc.
 	 *
+	 * \section state-fixed Fixed Timestep
+	 *
+	 * With a fixed timestep set on the StateManager, \c fixedUpdate() is called
+	 * zero or more times before each \c update(), with the same step length each
+	 * time, so the simulation runs at the same speed at any frame rate. Keep the
+	 * previous and current simulated positions, and draw between them in
+	 * \c update() using \c interpolation().
+	 *
 	 * \section state-template Base Template
 	 *
 	 * The following is a template State object. Use this as a starting point for building
@@ -107,6 +115,30 @@ namespace NAS2D
 		 *			NAS2D application.
 		 */
 		virtual State* update() = 0;
+
+
+		/**
+		 * Called at a fixed rate to advance the simulation, when the
+		 * StateManager has a fixed timestep.
+		 *
+		 * Does nothing unless overridden.
+		 *
+		 * \param	stepSeconds	Simulated time to advance, the same on every call.
+		 */
+		virtual void fixedUpdate(float /*stepSeconds*/) {}
+
+
+		/**
+		 * Fraction of a fixed step of real time not yet simulated, from 0
+		 * up to but not including 1. Always 0 without a fixed timestep.
+		 */
+		float interpolation() const
+		{
+			return mInterpolation;
+		}
+
+	private:
+		float mInterpolation{0.0f};
 	};
 
 } // namespace
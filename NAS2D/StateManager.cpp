@@ -58,6 +58,13 @@ void StateManager::setState(State* state)
 	mActiveState.reset(state);
 	mActiveState->initialize();
 
+	// Time spent switching states isn't simulated
+	if (mFixedTimestep)
+	{
+		mFixedTimestep->reset();
+		mLastStepTime = std::chrono::steady_clock::now();
+	}
+
 	mActive = true;
 }
 
@@ -70,6 +77,11 @@ bool StateManager::update()
 {
 	if (mActiveState)
 	{
+		if (mFixedTimestep)
+		{
+			runFixedSteps();
+		}
+
 		State* nextState = mActiveState->update();
 
 		if (!nextState)
@@ -92,6 +104,24 @@ bool StateManager::update()
 }
 
 
+/**
+ * Calls State::fixedUpdate() for each step of real time since the last frame,
+ * and sets the interpolation for the following State::update().
+ */
+void StateManager::runFixedSteps()
+{
+	const auto now = std::chrono::steady_clock::now();
+	const auto stepCount = mFixedTimestep->advance(now - mLastStepTime);
+	mLastStepTime = now;
+
+	for (unsigned int i = 0; i < stepCount; ++i)
+	{
+		mActiveState->fixedUpdate(mFixedTimestep->stepSeconds());
+	}
+	mActiveState->mInterpolation = mFixedTimestep->interpolation();
+}
+
+
 /**
  * Called when a quit event is raised.
  *
@@ -121,3 +151,35 @@ void StateManager::forceStopAudio(bool b)
 {
 	mForceStopAudio = b;
 }
+
+
+/**
+ * Runs the simulation of states in fixed steps, through State::fixedUpdate().
+ *
+ * \param	step				Simulated time per step, such as 1/60 of a second.
+ * \param	maxStepsPerFrame	Most steps run before a frame, beyond which the simulation slows down.
+ */
+void StateManager::setFixedTimestep(std::chrono::microseconds step, unsigned int maxStepsPerFrame)
+{
+	mFixedTimestep.emplace(step, maxStepsPerFrame);
+	mLastStepTime = std::chrono::steady_clock::now();
+}
+
+
+/**
+ * Returns to calling only State::update(), once per frame.
+ */
+void StateManager::clearFixedTimestep()
+{
+	mFixedTimestep.reset();
+	if (mActiveState)
+	{
+		mActiveState->mInterpolation = 0.0f;
+	}
+}
+
+
+const std::optional<FixedTimestep>& StateManager::fixedTimestep() const
+{
+	return mFixedTimestep;
+}
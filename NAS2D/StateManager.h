@@ -10,7 +10,11 @@
 
 #pragma once
 
+#include "FixedTimestep.h"
+
+#include <chrono>
 #include <memory>
+#include <optional>
 
 
 namespace NAS2D
@@ -40,12 +44,19 @@ namespace NAS2D
 
 		void forceStopAudio(bool);
 
+		void setFixedTimestep(std::chrono::microseconds step, unsigned int maxStepsPerFrame = FixedTimestep::DefaultMaxStepsPerFrame);
+		void clearFixedTimestep();
+		const std::optional<FixedTimestep>& fixedTimestep() const;
+
 	private:
 		void handleQuit();
+		void runFixedSteps();
 
 		std::unique_ptr<State> mActiveState;
 		bool mActive;
 		bool mForceStopAudio = true;
+		std::optional<FixedTimestep> mFixedTimestep;
+		std::chrono::steady_clock::time_point mLastStepTime;
 	};
 
 } // namespace
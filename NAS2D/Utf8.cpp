@@ -0,0 +1,109 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#include "Utf8.h"
+
+#include <cstdint>
+
+
+namespace
+{
+	bool isContinuationByte(uint8_t byte)
+	{
+		return (byte & 0xC0) == 0x80;
+	}
+}
+
+
+namespace NAS2D
+{
+	/**
+	 * Decodes a single codepoint from a UTF-8 encoded string.
+	 *
+	 * \param	text		UTF-8 encoded text.
+	 * \param	position	Byte offset of the codepoint to decode. Advanced past the decoded bytes.
+	 *
+	 * \return	Decoded codepoint, or ReplacementCharacter for a malformed sequence.
+	 *			Overlong encodings, surrogates, and values above U+10FFFF are malformed.
+	 *			A malformed sequence advances position by a single byte.
+	 */
+	char32_t decodeUtf8(std::string_view text, std::size_t& position)
+	{
+		const auto leadByte = static_cast<uint8_t>(text[position++]);
+		if (leadByte < 0x80)
+		{
+			return leadByte;
+		}
+
+		std::size_t length;
+		char32_t codepoint;
+		char32_t minimum;
+		if ((leadByte & 0xE0) == 0xC0)
+		{
+			length = 1;
+			codepoint = leadByte & 0x1Fu;
+			minimum = 0x80;
+		}
+		else if ((leadByte & 0xF0) == 0xE0)
+		{
+			length = 2;
+			codepoint = leadByte & 0x0Fu;
+			minimum = 0x800;
+		}
+		else if ((leadByte & 0xF8) == 0xF0)
+		{
+			length = 3;
+			codepoint = leadByte & 0x07u;
+			minimum = 0x10000;
+		}
+		else
+		{
+			return ReplacementCharacter;
+		}
+
+		if (text.size() - position < length)
+		{
+			return ReplacementCharacter;
+		}
+
+		for (std::size_t i = 0; i < length; ++i)
+		{
+			const auto byte = static_cast<uint8_t>(text[position + i]);
+			if (!isContinuationByte(byte))
+			{
+				return ReplacementCharacter;
+			}
+			codepoint = (codepoint << 6) | (byte & 0x3Fu);
+		}
+
+		if (codepoint < minimum || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+		{
+			return ReplacementCharacter;
+		}
+
+		position += length;
+		return codepoint;
+	}
+
+
+	/**
+	 * Decodes a UTF-8 encoded string to a string of codepoints.
+	 */
+	std::u32string utf8ToCodepoints(std::string_view text)
+	{
+		std::u32string codepoints;
+		codepoints.reserve(text.size());
+		for (const auto codepoint : Utf8CodepointRange{text})
+		{
+			codepoints.push_back(codepoint);
+		}
+		return codepoints;
+	}
+}
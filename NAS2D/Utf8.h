@@ -0,0 +1,108 @@
+// ==================================================================================
+// = NAS2D
+// = Copyright © 2008 - 2020 New Age Software
+// ==================================================================================
+// = NAS2D is distributed under the terms of the zlib license. You are free to copy,
+// = modify and distribute the software under the terms of the zlib license.
+// =
+// = Acknowledgment of your use of NAS2D is appreciated but is not required.
+// ==================================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+
+namespace NAS2D
+{
+	constexpr char32_t ReplacementCharacter{0xFFFD};
+
+	char32_t decodeUtf8(std::string_view text, std::size_t& position);
+	std::u32string utf8ToCodepoints(std::string_view text);
+
+
+	/**
+	 * Range of codepoints decoded from a UTF-8 encoded string.
+	 *
+	 * Malformed byte sequences decode as ReplacementCharacter.
+	 *
+	 * \code{.cpp}
+	 * for (const auto codepoint : Utf8CodepointRange{text})
+	 * {
+	 * 	// ...
+	 * }
+	 * \endcode
+	 */
+	class Utf8CodepointRange
+	{
+	public:
+		class Iterator
+		{
+		public:
+			Iterator(std::string_view text, std::size_t position) :
+				mText(text),
+				mPosition(position),
+				mNextPosition(position)
+			{
+				decode();
+			}
+
+			Iterator& operator++()
+			{
+				mPosition = mNextPosition;
+				decode();
+				return *this;
+			}
+
+			bool operator==(const Iterator& other) const
+			{
+				return mPosition == other.mPosition;
+			}
+
+			bool operator!=(const Iterator& other) const
+			{
+				return !(*this == other);
+			}
+
+			char32_t operator*() const
+			{
+				return mCodepoint;
+			}
+
+		private:
+			void decode()
+			{
+				if (mPosition < mText.size())
+				{
+					mCodepoint = decodeUtf8(mText, mNextPosition);
+				}
+			}
+
+			std::string_view mText;
+			std::size_t mPosition;
+			std::size_t mNextPosition;
+			char32_t mCodepoint{0};
+		};
+
+
+		Utf8CodepointRange(std::string_view text) :
+			mText(text)
+		{}
+
+		Iterator begin() const
+		{
+			return Iterator{mText, 0};
+		}
+
+		Iterator end() const
+		{
+			return Iterator{mText, mText.size()};
+		}
+
+	private:
+		std::string_view mText;
+	};
+
+} // namespace NAS2D
@@ -106,6 +106,14 @@ TEST_F(Filesystem, read) {
 	EXPECT_THROW(fs.readFile("FileDoesNotExist.txt"), std::runtime_error);
 }
 
+TEST_F(Filesystem, mapFile) {
+	const auto file = fs.mapFile("file.txt");
+	const auto data = file.data();
+	EXPECT_THAT((std::string{reinterpret_cast<const char*>(data.data()), data.size()}), testing::StartsWith("Test data"));
+
+	EXPECT_THROW(fs.mapFile("FileDoesNotExist.txt"), std::runtime_error);
+}
+
 // Test a few related methods. Some don't test well standalone.
 TEST_F(Filesystem, writeReadDeleteExists) {
 	const std::string testFilename = "TestFile.txt";
@@ -0,0 +1,58 @@
+#include "NAS2D/FixedTimestep.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <stdexcept>
+
+
+using namespace std::chrono_literals;
+
+
+TEST(FixedTimestep, ConstructInvalid) {
+	EXPECT_THROW(NAS2D::FixedTimestep{0us}, std::runtime_error);
+	EXPECT_THROW(NAS2D::FixedTimestep{-1us}, std::runtime_error);
+	EXPECT_THROW((NAS2D::FixedTimestep{10ms, 0}), std::runtime_error);
+}
+
+
+TEST(FixedTimestep, step) {
+	const NAS2D::FixedTimestep fixedTimestep{10ms, 3};
+	EXPECT_EQ(10000us, fixedTimestep.step());
+	EXPECT_FLOAT_EQ(0.01f, fixedTimestep.stepSeconds());
+	EXPECT_EQ(3u, fixedTimestep.maxStepsPerFrame());
+}
+
+
+TEST(FixedTimestep, advance) {
+	NAS2D::FixedTimestep fixedTimestep{10ms};
+	EXPECT_EQ(0u, fixedTimestep.advance(4ms));
+	EXPECT_FLOAT_EQ(0.4f, fixedTimestep.interpolation());
+
+	// Carried over time adds up to whole steps
+	EXPECT_EQ(1u, fixedTimestep.advance(7ms));
+	EXPECT_FLOAT_EQ(0.1f, fixedTimestep.interpolation());
+
+	EXPECT_EQ(2u, fixedTimestep.advance(20ms));
+	EXPECT_FLOAT_EQ(0.1f, fixedTimestep.interpolation());
+
+	// Clock going backwards adds nothing
+	EXPECT_EQ(0u, fixedTimestep.advance(-5ms));
+	EXPECT_FLOAT_EQ(0.1f, fixedTimestep.interpolation());
+
+	fixedTimestep.reset();
+	EXPECT_FLOAT_EQ(0.0f, fixedTimestep.interpolation());
+	EXPECT_EQ(0ns, fixedTimestep.droppedTime());
+}
+
+
+TEST(FixedTimestep, advanceDropsExcessSteps) {
+	NAS2D::FixedTimestep fixedTimestep{10ms, 5};
+	EXPECT_EQ(5u, fixedTimestep.advance(1s + 5ms));
+	EXPECT_EQ(950ms, fixedTimestep.droppedTime());
+	EXPECT_FLOAT_EQ(0.5f, fixedTimestep.interpolation());
+
+	// Doesn't fall further behind on the following frames
+	EXPECT_EQ(1u, fixedTimestep.advance(10ms));
+	EXPECT_EQ(950ms, fixedTimestep.droppedTime());
+}
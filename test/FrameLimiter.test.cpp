@@ -0,0 +1,64 @@
+#include "NAS2D/FrameLimiter.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+
+TEST(FrameLimiter, targetFps) {
+	NAS2D::FrameLimiter frameLimiter;
+	EXPECT_EQ(0u, frameLimiter.targetFps());
+
+	frameLimiter.setTargetFps(60);
+	EXPECT_EQ(60u, frameLimiter.targetFps());
+}
+
+
+TEST(FrameLimiter, waitWithoutTargetOnlyMeasures) {
+	NAS2D::FrameLimiter frameLimiter;
+	frameLimiter.wait();
+	EXPECT_EQ(0u, frameLimiter.frameTimeStats().frameCount);
+
+	frameLimiter.wait();
+	frameLimiter.wait();
+	EXPECT_EQ(2u, frameLimiter.frameTimeStats().frameCount);
+
+	frameLimiter.resetFrameTimeStats();
+	frameLimiter.wait();
+	EXPECT_EQ(0u, frameLimiter.frameTimeStats().frameCount);
+}
+
+
+TEST(FrameLimiter, waitPacesFrames) {
+	// Only lower bounds, as a busy machine can always run late
+	constexpr unsigned int frameCount{10};
+	NAS2D::FrameLimiter frameLimiter{200};
+
+	frameLimiter.wait();
+	const auto start = NAS2D::FrameLimiter::Clock::now();
+	for (unsigned int i = 0; i < frameCount; ++i) {
+		frameLimiter.wait();
+	}
+	const auto elapsed = NAS2D::FrameLimiter::Clock::now() - start;
+
+	EXPECT_GE(elapsed, std::chrono::milliseconds{frameCount * 5 - 1});
+	const auto stats = frameLimiter.frameTimeStats();
+	EXPECT_EQ(frameCount, stats.frameCount);
+	EXPECT_GE(stats.average.count(), 4.99);
+	EXPECT_GE(stats.maximum, stats.average);
+	EXPECT_GE(stats.jitter.count(), 0.0);
+}
+
+
+TEST(FrameLimiter, lateFrameDoesNotCatchUp) {
+	NAS2D::FrameLimiter frameLimiter{200};
+	frameLimiter.wait();
+	std::this_thread::sleep_for(std::chrono::milliseconds{30});
+	frameLimiter.wait();
+
+	// The schedule restarts from the late frame, rather than rushing through missed deadlines
+	const auto start = NAS2D::FrameLimiter::Clock::now();
+	frameLimiter.wait();
+	EXPECT_GE(NAS2D::FrameLimiter::Clock::now() - start, std::chrono::milliseconds{4});
+}
@@ -0,0 +1,23 @@
+#include "NAS2D/Hash.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+
+
+TEST(Hash, xxHash64) {
+	EXPECT_EQ(0xEF46DB3751D8E999u, NAS2D::xxHash64(""));
+	EXPECT_EQ(0x44BC2CF5AD770999u, NAS2D::xxHash64("abc"));
+	EXPECT_EQ(0x0B242D361FDA71BCu, NAS2D::xxHash64("The quick brown fox jumps over the lazy dog"));
+}
+
+TEST(Hash, xxHash64Seed) {
+	EXPECT_EQ(0xBEA9CA8199328908u, NAS2D::xxHash64("abc", 1));
+
+	std::array<uint8_t, 100> data{};
+	for (std::size_t i = 0; i < data.size(); ++i) {
+		data[i] = static_cast<uint8_t>(i);
+	}
+	EXPECT_EQ(0x9C5395B5DA7D2126u, NAS2D::xxHash64(data.data(), data.size(), 0x1234u));
+}
@@ -0,0 +1,29 @@
+#include "NAS2D/MappedFile.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+
+TEST(MappedFile, data) {
+	const auto file = NAS2D::MappedFile{"data/file.txt"};
+	const auto data = file.data();
+	EXPECT_EQ(file.size(), data.size());
+	EXPECT_TRUE((std::string_view{reinterpret_cast<const char*>(data.data()), data.size()}.starts_with("Test data")));
+}
+
+TEST(MappedFile, move) {
+	auto file = NAS2D::MappedFile{"data/file.txt"};
+	const auto size = file.size();
+
+	auto movedFile = std::move(file);
+	EXPECT_EQ(size, movedFile.size());
+	EXPECT_EQ(0u, file.size());
+	EXPECT_TRUE(file.data().empty());
+}
+
+TEST(MappedFile, missingFile) {
+	EXPECT_THROW(NAS2D::MappedFile{"data/FileDoesNotExist.txt"}, std::runtime_error);
+}
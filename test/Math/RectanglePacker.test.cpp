@@ -0,0 +1,65 @@
+#include "NAS2D/Math/RectanglePacker.h"
+#include "NAS2D/Math/Rectangle.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+
+TEST(RectanglePacker, add) {
+	NAS2D::RectanglePacker packer{{8, 8}};
+
+	EXPECT_EQ((NAS2D::Point{0, 0}), packer.add({4, 4}));
+	EXPECT_EQ((NAS2D::Point{4, 0}), packer.add({4, 2}));
+	EXPECT_EQ((NAS2D::Point{0, 4}), packer.add({2, 2}));
+	EXPECT_EQ(6, packer.usedHeight());
+}
+
+TEST(RectanglePacker, addPadding) {
+	NAS2D::RectanglePacker packer{{8, 8}, 1};
+
+	EXPECT_EQ((NAS2D::Point{1, 1}), packer.add({2, 2}));
+	EXPECT_EQ((NAS2D::Point{4, 1}), packer.add({2, 2}));
+	EXPECT_EQ((NAS2D::Point{1, 4}), packer.add({6, 2}));
+}
+
+TEST(RectanglePacker, addBestFitShelf) {
+	NAS2D::RectanglePacker packer{{8, 8}};
+
+	packer.add({2, 4});
+	packer.add({8, 2});
+	// Prefer the shorter shelf with space over the taller one
+	EXPECT_EQ((NAS2D::Point{2, 0}), packer.add({2, 3}));
+	EXPECT_EQ((NAS2D::Point{0, 6}), packer.add({8, 2}));
+}
+
+TEST(RectanglePacker, addFull) {
+	NAS2D::RectanglePacker packer{{4, 4}};
+
+	EXPECT_EQ(std::nullopt, packer.add({5, 1}));
+	EXPECT_EQ(std::nullopt, packer.add({1, 5}));
+	EXPECT_NE(std::nullopt, packer.add({4, 3}));
+	EXPECT_EQ(std::nullopt, packer.add({1, 2}));
+	EXPECT_NE(std::nullopt, packer.add({4, 1}));
+	EXPECT_EQ(std::nullopt, packer.add({1, 1}));
+}
+
+TEST(RectanglePacker, addNoOverlap) {
+	NAS2D::RectanglePacker packer{{64, 64}, 1};
+	std::vector<NAS2D::Rectangle<int>> placed;
+
+	for (int i = 0; i < 100; ++i) {
+		const auto itemSize = NAS2D::Vector{3 + i % 5, 4 + i % 3};
+		const auto position = packer.add(itemSize);
+		if (!position) {
+			break;
+		}
+		const auto rect = NAS2D::Rectangle{*position, itemSize};
+		EXPECT_TRUE((NAS2D::Rectangle<int>{{0, 0}, {64, 64}}.contains(rect)));
+		for (const auto& other : placed) {
+			EXPECT_FALSE(rect.overlaps(other));
+		}
+		placed.push_back(rect);
+	}
+	EXPECT_LT(50u, placed.size());
+}
@@ -0,0 +1,112 @@
+#include "NAS2D/Renderer/DrawList.h"
+#include "NAS2D/Renderer/RendererNull.h"
+#include "NAS2D/Resource/Image.h"
+#include "NAS2D/Utility.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+
+namespace {
+	class RecordingRenderer : public NAS2D::RendererNull {
+	public:
+		struct Draw {
+			const NAS2D::Image* image;
+			NAS2D::Point<float> position;
+
+			bool operator==(const Draw& other) const = default;
+		};
+
+		void drawSubImage(const NAS2D::Image& image, NAS2D::Point<float> raster, const NAS2D::Rectangle<float>&, NAS2D::Color) override {
+			draws.push_back({&image, raster});
+		}
+
+		std::vector<Draw> draws;
+	};
+}
+
+
+class DrawList : public ::testing::Test {
+protected:
+	DrawList() :
+		renderer{NAS2D::Utility<NAS2D::Renderer>::init<RecordingRenderer>()}
+	{}
+
+	~DrawList() override {
+		NAS2D::Utility<NAS2D::Renderer>::clear();
+	}
+
+	RecordingRenderer& renderer;
+	uint32_t bufferA[1]{};
+	uint32_t bufferB[1]{};
+	NAS2D::Image imageA{&bufferA, 4, {1, 1}};
+	NAS2D::Image imageB{&bufferB, 4, {1, 1}};
+	NAS2D::DrawList drawList;
+};
+
+
+TEST_F(DrawList, sortsByLayerThenDepth) {
+	drawList.add(imageA, {0, 0}, 1, 5.0f);
+	drawList.add(imageA, {1, 0}, 0, 7.0f);
+	drawList.add(imageA, {2, 0}, 1, -2.5f);
+	drawList.add(imageA, {3, 0}, -1, 100.0f);
+	drawList.add(imageA, {4, 0}, 0, -7.0f);
+	EXPECT_EQ(5u, drawList.size());
+
+	drawList.flush();
+
+	const auto positions = std::vector<float>{3, 4, 1, 2, 0};
+	ASSERT_EQ(positions.size(), renderer.draws.size());
+	for (std::size_t i = 0; i < positions.size(); ++i) {
+		EXPECT_EQ(positions[i], renderer.draws[i].position.x);
+	}
+	EXPECT_TRUE(drawList.empty());
+}
+
+TEST_F(DrawList, groupsEqualKeysByImage) {
+	drawList.add(imageA, {0, 0}, 0, 1.0f);
+	drawList.add(imageB, {1, 0}, 0, 1.0f);
+	drawList.add(imageA, {2, 0}, 0, 1.0f);
+	drawList.add(imageB, {3, 0}, 0, 0.0f);
+
+	drawList.flush();
+
+	EXPECT_EQ((std::vector<RecordingRenderer::Draw>{{&imageB, {3, 0}}, {&imageA, {0, 0}}, {&imageA, {2, 0}}, {&imageB, {1, 0}}}), renderer.draws);
+}
+
+TEST_F(DrawList, matchesStableSort) {
+	struct Item {
+		int layer;
+		float depth;
+		float position;
+	};
+
+	std::vector<Item> items;
+	unsigned int seed = 1;
+	for (int i = 0; i < 1000; ++i) {
+		seed = seed * 1103515245u + 12345u;
+		const auto layer = static_cast<int>((seed >> 8) % 5) - 2;
+		const auto depth = static_cast<float>(static_cast<int>((seed >> 16) % 200) - 100) / 4.0f;
+		items.push_back({layer, depth, static_cast<float>(i)});
+		drawList.add(imageA, {items.back().position, 0}, layer, depth);
+	}
+
+	drawList.flush();
+
+	std::stable_sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+		return a.layer != b.layer ? a.layer < b.layer : a.depth < b.depth;
+	});
+	ASSERT_EQ(items.size(), renderer.draws.size());
+	for (std::size_t i = 0; i < items.size(); ++i) {
+		EXPECT_EQ(items[i].position, renderer.draws[i].position.x);
+	}
+}
+
+TEST_F(DrawList, layerOutOfRange) {
+	EXPECT_THROW(drawList.add(imageA, {0, 0}, NAS2D::DrawList::MaxLayer + 1, 0.0f), std::runtime_error);
+	EXPECT_THROW(drawList.add(imageA, {0, 0}, NAS2D::DrawList::MinLayer - 1, 0.0f), std::runtime_error);
+	EXPECT_TRUE(drawList.empty());
+}
@@ -0,0 +1,116 @@
+#include "NAS2D/Renderer/PathMesh.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+
+namespace {
+	float meshArea(const NAS2D::PathMesh& mesh) {
+		const auto& vertices = mesh.vertices();
+		float area = 0;
+		for (std::size_t i = 0; i < vertices.size(); i += 3) {
+			const auto ab = vertices[i + 1] - vertices[i];
+			const auto ac = vertices[i + 2] - vertices[i];
+			area += std::abs(ab.x * ac.y - ab.y * ac.x) / 2;
+		}
+		return area;
+	}
+
+	bool hasVertexNear(const NAS2D::PathMesh& mesh, NAS2D::Point<float> point) {
+		const auto& vertices = mesh.vertices();
+		return std::any_of(vertices.begin(), vertices.end(), [point](NAS2D::Point<float> vertex) {
+			return (vertex - point).lengthSquared() < 0.0001f;
+		});
+	}
+}
+
+
+TEST(PathMesh, empty) {
+	EXPECT_TRUE(NAS2D::PathMesh{}.empty());
+
+	const std::vector<NAS2D::Point<float>> single{{1, 1}, {1, 1}};
+	EXPECT_TRUE(NAS2D::PathMesh::polyline(single, 2.0f).empty());
+	EXPECT_TRUE(NAS2D::PathMesh::polygon(single).empty());
+
+	const std::vector<NAS2D::Point<float>> line{{0, 0}, {10, 0}};
+	EXPECT_TRUE(NAS2D::PathMesh::polyline(line, 0.0f).empty());
+}
+
+
+TEST(PathMesh, polylineStraight) {
+	const std::vector<NAS2D::Point<float>> points{{0, 0}, {5, 0}, {10, 0}};
+	const auto mesh = NAS2D::PathMesh::polyline(points, 2.0f);
+	EXPECT_EQ(4u, mesh.triangleCount());
+	EXPECT_FLOAT_EQ(20.0f, meshArea(mesh));
+}
+
+
+TEST(PathMesh, polylineMiterJoin) {
+	// Right angle corner, with the outside corner mitered out to (11, -1)
+	const std::vector<NAS2D::Point<float>> points{{0, 0}, {10, 0}, {10, 10}};
+	const auto mesh = NAS2D::PathMesh::polyline(points, 2.0f);
+	EXPECT_EQ(4u, mesh.triangleCount());
+	EXPECT_FLOAT_EQ(40.0f, meshArea(mesh));
+
+	EXPECT_TRUE(hasVertexNear(mesh, {11.0f, -1.0f}));
+	EXPECT_TRUE(hasVertexNear(mesh, {9.0f, 1.0f}));
+}
+
+
+TEST(PathMesh, polylineBevelJoin) {
+	// Sharp turn back exceeds the miter limit, and gets a bevel triangle
+	const std::vector<NAS2D::Point<float>> points{{0, 0}, {10, 0}, {0, 1}};
+	const auto mesh = NAS2D::PathMesh::polyline(points, 2.0f);
+	EXPECT_EQ(5u, mesh.triangleCount());
+	for (const auto& vertex : mesh.vertices()) {
+		EXPECT_LE(vertex.x, 11.0f);
+	}
+}
+
+
+TEST(PathMesh, polylineClosed) {
+	const std::vector<NAS2D::Point<float>> square{{0, 0}, {10, 0}, {10, 10}, {0, 10}, {0, 0}};
+	const auto mesh = NAS2D::PathMesh::polyline(square, 2.0f, true);
+	EXPECT_EQ(8u, mesh.triangleCount());
+	// Outer 12x12 square less inner 8x8 square
+	EXPECT_FLOAT_EQ(80.0f, meshArea(mesh));
+}
+
+
+TEST(PathMesh, polygonConvex) {
+	const std::vector<NAS2D::Point<float>> square{{0, 0}, {10, 0}, {10, 10}, {0, 10}};
+	const auto mesh = NAS2D::PathMesh::polygon(square);
+	EXPECT_EQ(2u, mesh.triangleCount());
+	EXPECT_FLOAT_EQ(100.0f, meshArea(mesh));
+}
+
+
+TEST(PathMesh, polygonConcave) {
+	// L shape, wound both ways
+	std::vector<NAS2D::Point<float>> shape{{0, 0}, {10, 0}, {10, 5}, {5, 5}, {5, 10}, {0, 10}};
+	for (int i = 0; i < 2; ++i) {
+		const auto mesh = NAS2D::PathMesh::polygon(shape);
+		EXPECT_EQ(4u, mesh.triangleCount());
+		EXPECT_FLOAT_EQ(75.0f, meshArea(mesh));
+		std::reverse(shape.begin(), shape.end());
+	}
+}
+
+
+TEST(PathMesh, polygonCollinear) {
+	const std::vector<NAS2D::Point<float>> square{{0, 0}, {5, 0}, {10, 0}, {10, 10}, {0, 10}};
+	const auto mesh = NAS2D::PathMesh::polygon(square);
+	EXPECT_GE(3u, mesh.triangleCount());
+	EXPECT_FLOAT_EQ(100.0f, meshArea(mesh));
+}
+
+
+TEST(PathMesh, append) {
+	const std::vector<NAS2D::Point<float>> square{{0, 0}, {10, 0}, {10, 10}, {0, 10}};
+	auto mesh = NAS2D::PathMesh::polygon(square);
+	mesh.append(NAS2D::PathMesh::polyline(square, 2.0f, true));
+	EXPECT_EQ(10u, mesh.triangleCount());
+}
@@ -0,0 +1,69 @@
+#include "NAS2D/Renderer/ResolutionScale.h"
+
+#include <gtest/gtest.h>
+
+
+TEST(ResolutionScale, scaleViewport) {
+	EXPECT_EQ((NAS2D::Rectangle<int>{{0, 0}, {800, 600}}), NAS2D::scaleViewport({{0, 0}, {800, 600}}, 1.0f));
+	EXPECT_EQ((NAS2D::Rectangle<int>{{5, 10}, {400, 300}}), NAS2D::scaleViewport({{10, 20}, {800, 600}}, 0.5f));
+	// Rounded to nearest
+	EXPECT_EQ((NAS2D::Rectangle<int>{{0, 0}, {534, 400}}), NAS2D::scaleViewport({{0, 0}, {801, 600}}, 2.0f / 3.0f));
+	// Never empty
+	EXPECT_EQ((NAS2D::Rectangle<int>{{0, 0}, {1, 1}}), NAS2D::scaleViewport({{0, 0}, {1, 1}}, 0.25f));
+	EXPECT_EQ((NAS2D::Rectangle<int>{{0, 0}, {1, 1}}), NAS2D::scaleViewport({{0, 0}, {0, 0}}, 1.0f));
+}
+
+
+TEST(ResolutionScale, sceneTargetSize) {
+	EXPECT_EQ((NAS2D::Vector{800, 600}), NAS2D::sceneTargetSize({800, 600}, 1.0f));
+	// Rounded up, so the largest scaled viewport fits
+	EXPECT_EQ((NAS2D::Vector{534, 401}), NAS2D::sceneTargetSize({801, 601}, 2.0f / 3.0f));
+	EXPECT_EQ((NAS2D::Vector{1, 1}), NAS2D::sceneTargetSize({0, 0}, 1.0f));
+	const auto viewport = NAS2D::scaleViewport({{0, 0}, {801, 601}}, 2.0f / 3.0f);
+	EXPECT_LE(viewport.size.x, NAS2D::sceneTargetSize({801, 601}, 2.0f / 3.0f).x);
+	EXPECT_LE(viewport.size.y, NAS2D::sceneTargetSize({801, 601}, 2.0f / 3.0f).y);
+}
+
+
+TEST(ResolutionScale, sceneUvSize) {
+	const auto fullUv = NAS2D::sceneUvSize({800, 600}, 1.0f, {800, 600});
+	EXPECT_FLOAT_EQ(1.0f, fullUv.x);
+	EXPECT_FLOAT_EQ(1.0f, fullUv.y);
+
+	const auto halfUv = NAS2D::sceneUvSize({800, 600}, 0.5f, {800, 600});
+	EXPECT_FLOAT_EQ(0.5f, halfUv.x);
+	EXPECT_FLOAT_EQ(0.5f, halfUv.y);
+
+	// Covers the rounded viewport exactly
+	const auto targetSize = NAS2D::sceneTargetSize({801, 600}, 1.0f);
+	const auto uv = NAS2D::sceneUvSize({801, 600}, 2.0f / 3.0f, targetSize);
+	EXPECT_FLOAT_EQ(534.0f / 801.0f, uv.x);
+	EXPECT_FLOAT_EQ(400.0f / 600.0f, uv.y);
+}
+
+
+TEST(ResolutionScale, adjustResolutionScaleSettled) {
+	// Within the band just below the target, the scale is left alone
+	EXPECT_FLOAT_EQ(0.8f, NAS2D::adjustResolutionScale(0.8f, 16.0f, 16.0f, 0.5f, 1.0f));
+	EXPECT_FLOAT_EQ(0.8f, NAS2D::adjustResolutionScale(0.8f, 14.0f, 16.0f, 0.5f, 1.0f));
+}
+
+
+TEST(ResolutionScale, adjustResolutionScaleSteps) {
+	// Slow frames lower the scale, by at most 10%
+	const auto lowered = NAS2D::adjustResolutionScale(0.8f, 17.0f, 16.0f, 0.5f, 1.0f);
+	EXPECT_LT(lowered, 0.8f);
+	EXPECT_FLOAT_EQ(0.72f, NAS2D::adjustResolutionScale(0.8f, 100.0f, 16.0f, 0.5f, 1.0f));
+
+	// Fast frames raise the scale, by at most 5%
+	const auto raised = NAS2D::adjustResolutionScale(0.8f, 13.0f, 16.0f, 0.5f, 1.0f);
+	EXPECT_GT(raised, 0.8f);
+	EXPECT_FLOAT_EQ(0.84f, NAS2D::adjustResolutionScale(0.8f, 1.0f, 16.0f, 0.5f, 1.0f));
+	EXPECT_FLOAT_EQ(0.84f, NAS2D::adjustResolutionScale(0.8f, 0.0f, 16.0f, 0.5f, 1.0f));
+}
+
+
+TEST(ResolutionScale, adjustResolutionScaleClamped) {
+	EXPECT_FLOAT_EQ(0.5f, NAS2D::adjustResolutionScale(0.52f, 100.0f, 16.0f, 0.5f, 1.0f));
+	EXPECT_FLOAT_EQ(1.0f, NAS2D::adjustResolutionScale(0.98f, 1.0f, 16.0f, 0.5f, 1.0f));
+}
@@ -0,0 +1,28 @@
+#include "NAS2D/Renderer/TextCache.h"
+
+#include <gtest/gtest.h>
+
+
+// Baking text needs a Font, which needs an OpenGL context for its glyph atlas,
+// so only the cache bookkeeping is tested here. Eviction is tested with LruCache.
+
+TEST(TextCache, empty) {
+	const NAS2D::TextCache textCache;
+	EXPECT_EQ(NAS2D::TextCache::DefaultMemoryLimit, textCache.memoryLimit());
+	EXPECT_EQ(0u, textCache.size());
+	EXPECT_EQ(0u, textCache.memoryUsage());
+	EXPECT_EQ(0u, textCache.hits());
+	EXPECT_EQ(0u, textCache.misses());
+}
+
+TEST(TextCache, memoryLimit) {
+	NAS2D::TextCache textCache{1024};
+	EXPECT_EQ(1024u, textCache.memoryLimit());
+
+	textCache.memoryLimit(4096);
+	EXPECT_EQ(4096u, textCache.memoryLimit());
+
+	textCache.clear();
+	EXPECT_EQ(0u, textCache.size());
+	EXPECT_EQ(4096u, textCache.memoryLimit());
+}
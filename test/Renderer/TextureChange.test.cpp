@@ -0,0 +1,31 @@
+#include "NAS2D/Renderer/TextureChange.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+
+namespace {
+	struct TextureChangeRecorder {
+		std::vector<unsigned int> textureIds{};
+
+		void onTextureChange(unsigned int textureId) { textureIds.push_back(textureId); }
+	};
+}
+
+
+TEST(TextureChange, beforeTextureChange) {
+	// Nothing to call without a handler
+	NAS2D::beforeTextureChange(1);
+
+	TextureChangeRecorder recorder;
+	NAS2D::setTextureChangeHandler({&recorder, &TextureChangeRecorder::onTextureChange});
+	NAS2D::beforeTextureChange(2);
+	// No texture
+	NAS2D::beforeTextureChange(0);
+
+	NAS2D::setTextureChangeHandler({});
+	NAS2D::beforeTextureChange(3);
+
+	EXPECT_EQ((std::vector<unsigned int>{2}), recorder.textureIds);
+}
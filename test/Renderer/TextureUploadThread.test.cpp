@@ -0,0 +1,72 @@
+#include "NAS2D/Renderer/TextureUploadThread.h"
+#include "NAS2D/Resource/Image.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+
+// Without a window there is no GL context to share, so uploads fall back to the main thread
+
+TEST(TextureUploadThread, fallbackWithoutContext) {
+	const NAS2D::TextureUploadThread uploadThread;
+	EXPECT_FALSE(uploadThread.isThreaded());
+	EXPECT_TRUE(uploadThread.empty());
+}
+
+TEST(TextureUploadThread, pushCancel) {
+	uint32_t buffer1[1 * 1]{};
+	uint32_t buffer2[1 * 1]{};
+	const auto image1 = NAS2D::Image{&buffer1, 4, {1, 1}};
+	const auto image2 = NAS2D::Image{&buffer2, 4, {1, 1}};
+
+	NAS2D::TextureUploadThread uploadThread;
+	uploadThread.push(image1);
+	uploadThread.push(image2);
+	EXPECT_FALSE(uploadThread.empty());
+
+	uploadThread.cancel(image1);
+	EXPECT_FALSE(uploadThread.empty());
+	uploadThread.cancel(image2);
+	EXPECT_TRUE(uploadThread.empty());
+
+	// Cancelling an image that isn't queued has no effect
+	uploadThread.cancel(image1);
+	EXPECT_TRUE(uploadThread.empty());
+}
+
+TEST(TextureUploadThread, pushTwiceQueuesOnce) {
+	uint32_t buffer[1 * 1]{};
+	const auto image = NAS2D::Image{&buffer, 4, {1, 1}};
+
+	NAS2D::TextureUploadThread uploadThread;
+	uploadThread.push(image);
+	uploadThread.push(image);
+	uploadThread.cancel(image);
+	EXPECT_TRUE(uploadThread.empty());
+}
+
+TEST(TextureUploadThread, updateCancelled) {
+	uint32_t buffer[1 * 1]{};
+	const auto image = NAS2D::Image{&buffer, 4, {1, 1}};
+
+	NAS2D::TextureUploadThread uploadThread;
+	uploadThread.push(image);
+	uploadThread.cancel(image);
+
+	// Nothing is left to upload, so the image stays without a texture
+	uploadThread.update();
+	EXPECT_TRUE(uploadThread.empty());
+	EXPECT_FALSE(image.isUploaded());
+}
+
+TEST(TextureUploadThread, destroyedImageRemovesItself) {
+	NAS2D::TextureUploadThread uploadThread;
+	{
+		uint32_t buffer[1 * 1]{};
+		const auto image = NAS2D::Image{&buffer, 4, {1, 1}};
+		uploadThread.push(image);
+		EXPECT_FALSE(uploadThread.empty());
+	}
+	EXPECT_TRUE(uploadThread.empty());
+}
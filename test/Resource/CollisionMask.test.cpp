@@ -0,0 +1,106 @@
+#include "NAS2D/Resource/CollisionMask.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+
+namespace
+{
+	NAS2D::CollisionMask patternMask(NAS2D::Vector<int> size, unsigned int seed)
+	{
+		auto mask = NAS2D::CollisionMask{size};
+		for (int y = 0; y < size.y; ++y)
+		{
+			for (int x = 0; x < size.x; ++x)
+			{
+				seed = seed * 1103515245u + 12345u;
+				mask.set({x, y}, (seed >> 16) % 7 == 0);
+			}
+		}
+		return mask;
+	}
+
+	bool bruteForceOverlaps(const NAS2D::CollisionMask& mask, const NAS2D::CollisionMask& other, NAS2D::Vector<int> offset)
+	{
+		for (int y = 0; y < other.size().y; ++y)
+		{
+			for (int x = 0; x < other.size().x; ++x)
+			{
+				if (other.contains({x, y}) && mask.contains(NAS2D::Point{x, y} + offset))
+				{
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+}
+
+
+TEST(CollisionMask, setContains) {
+	auto mask = NAS2D::CollisionMask{{130, 3}};
+
+	EXPECT_EQ((NAS2D::Vector{130, 3}), mask.size());
+	EXPECT_FALSE(mask.contains({129, 2}));
+
+	mask.set({129, 2}, true);
+	mask.set({64, 1}, true);
+	EXPECT_TRUE(mask.contains({129, 2}));
+	EXPECT_TRUE(mask.contains({64, 1}));
+	EXPECT_FALSE(mask.contains({63, 1}));
+	EXPECT_FALSE(mask.contains({130, 2}));
+	EXPECT_FALSE(mask.contains({-1, 0}));
+
+	mask.set({64, 1}, false);
+	EXPECT_FALSE(mask.contains({64, 1}));
+
+	EXPECT_THROW(mask.set({130, 0}, true), std::runtime_error);
+	EXPECT_THROW(mask.set({0, -1}, true), std::runtime_error);
+}
+
+TEST(CollisionMask, overlapsSinglePixels) {
+	auto mask = NAS2D::CollisionMask{{100, 2}};
+	auto other = NAS2D::CollisionMask{{10, 1}};
+	mask.set({70, 1}, true);
+	other.set({3, 0}, true);
+
+	EXPECT_TRUE(mask.overlaps(other, {67, 1}));
+	EXPECT_TRUE(other.overlaps(mask, {-67, -1}));
+	EXPECT_FALSE(mask.overlaps(other, {66, 1}));
+	EXPECT_FALSE(mask.overlaps(other, {67, 0}));
+	EXPECT_FALSE(mask.overlaps(other, {100, 1}));
+	EXPECT_FALSE(mask.overlaps(other, {67, 2}));
+}
+
+TEST(CollisionMask, overlapsMatchesBruteForce) {
+	const auto mask = patternMask({150, 9}, 1);
+	const auto other = patternMask({70, 5}, 2);
+
+	for (int y = -6; y <= 10; ++y)
+	{
+		for (int x = -72; x <= 152; ++x)
+		{
+			const auto offset = NAS2D::Vector{x, y};
+			EXPECT_EQ(bruteForceOverlaps(mask, other, offset), mask.overlaps(other, offset)) << x << ", " << y;
+		}
+	}
+}
+
+TEST(CollisionMask, subMask) {
+	const auto mask = patternMask({200, 4}, 3);
+	const auto rect = NAS2D::Rectangle<int>{{37, 1}, {100, 3}};
+	const auto sub = mask.subMask(rect);
+
+	EXPECT_EQ(rect.size, sub.size());
+	for (int y = 0; y < rect.size.y; ++y)
+	{
+		for (int x = 0; x < rect.size.x + 2; ++x)
+		{
+			EXPECT_EQ(x < rect.size.x && mask.contains({rect.position.x + x, rect.position.y + y}), sub.contains({x, y}));
+		}
+	}
+
+	EXPECT_THROW(mask.subMask({{150, 0}, {51, 1}}), std::runtime_error);
+	EXPECT_THROW(mask.subMask({{-1, 0}, {2, 1}}), std::runtime_error);
+}
@@ -0,0 +1,53 @@
+#include "NAS2D/Resource/CookedImage.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace {
+	std::span<std::byte> bytes(std::string& data) {
+		return {reinterpret_cast<std::byte*>(data.data()), data.size()};
+	}
+}
+
+
+TEST(CookedImage, roundTrip) {
+	const std::vector<NAS2D::Color> pixels{NAS2D::Color::Red, NAS2D::Color::Green, NAS2D::Color::Blue, NAS2D::Color{1, 2, 3, 4}, NAS2D::Color::White, NAS2D::Color::Black};
+	auto data = NAS2D::cookImage({3, 2}, pixels);
+
+	const auto cookedImage = NAS2D::parseCookedImage(bytes(data));
+	ASSERT_TRUE(cookedImage);
+	EXPECT_EQ((NAS2D::Vector{3, 2}), cookedImage->size);
+	EXPECT_EQ(pixels, (std::vector<NAS2D::Color>{cookedImage->pixels.begin(), cookedImage->pixels.end()}));
+	// Pixels are used in place
+	EXPECT_EQ(reinterpret_cast<std::byte*>(data.data()) + (data.size() - pixels.size() * sizeof(NAS2D::Color)), reinterpret_cast<std::byte*>(cookedImage->pixels.data()));
+}
+
+TEST(CookedImage, notCooked) {
+	std::string data{"\x89PNG\r\n\x1a\n not a cooked image"};
+	EXPECT_EQ(std::nullopt, NAS2D::parseCookedImage(bytes(data)));
+
+	std::string empty;
+	EXPECT_EQ(std::nullopt, NAS2D::parseCookedImage(bytes(empty)));
+}
+
+TEST(CookedImage, corrupt) {
+	const std::vector<NAS2D::Color> pixels(4);
+	const auto data = NAS2D::cookImage({2, 2}, pixels);
+
+	auto truncated = data.substr(0, data.size() - 1);
+	EXPECT_THROW(NAS2D::parseCookedImage(bytes(truncated)), std::runtime_error);
+
+	auto truncatedHeader = data.substr(0, 12);
+	EXPECT_THROW(NAS2D::parseCookedImage(bytes(truncatedHeader)), std::runtime_error);
+
+	auto wrongVersion = data;
+	wrongVersion[8] = '\x7f';
+	EXPECT_THROW(NAS2D::parseCookedImage(bytes(wrongVersion)), std::runtime_error);
+
+	EXPECT_THROW(NAS2D::cookImage({3, 2}, pixels), std::runtime_error);
+}
@@ -0,0 +1,39 @@
+#include "NAS2D/Resource/DistanceField.h"
+
+#include <gtest/gtest.h>
+
+
+TEST(DistanceField, size) {
+	const std::vector<uint8_t> coverage(6, 0);
+	EXPECT_EQ(12u * 13u, NAS2D::distanceField(coverage, {2, 3}, 5).size());
+}
+
+TEST(DistanceField, empty) {
+	const std::vector<uint8_t> coverage(4, 127);
+	for (const auto value : NAS2D::distanceField(coverage, {2, 2}, 2)) {
+		EXPECT_EQ(0u, value);
+	}
+}
+
+TEST(DistanceField, edge) {
+	// Left half of the image is inside the shape
+	const std::vector<uint8_t> coverage{
+		255, 255, 0, 0,
+		255, 255, 0, 0,
+	};
+	const auto field = NAS2D::distanceField(coverage, {4, 2}, 2);
+	ASSERT_EQ(8u * 6u, field.size());
+
+	// Row through the middle of the padded field
+	const auto* row = field.data() + 2 * 8;
+	// Pixels either side of the edge are an equal distance from it
+	EXPECT_EQ(255 - row[4], row[3]);
+	EXPECT_LT(128, row[3]);
+	EXPECT_GT(128, row[4]);
+	// Values fall off with distance outside the shape, and clamp beyond the spread
+	EXPECT_GT(row[4], row[5]);
+	EXPECT_EQ(0u, row[7]);
+	// Padding left of the shape is outside
+	EXPECT_GT(128, row[0]);
+	EXPECT_LT(row[0], row[1]);
+}
@@ -0,0 +1,46 @@
+#include "NAS2D/Resource/DynamicImage.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+
+TEST(DynamicImage, startsTransparent) {
+	const auto image = NAS2D::DynamicImage{{3, 2}};
+
+	EXPECT_EQ((NAS2D::Vector{3, 2}), image.size());
+	EXPECT_EQ((NAS2D::Color{0, 0, 0, 0}), image.pixelColor({0, 0}));
+	EXPECT_EQ((NAS2D::Color{0, 0, 0, 0}), image.pixelColor({2, 1}));
+	EXPECT_EQ(NAS2D::Image::SurfaceRetention::Release, image.surfaceRetention());
+}
+
+TEST(DynamicImage, updateOutOfBounds) {
+	auto image = NAS2D::DynamicImage{{3, 2}};
+	const std::vector<NAS2D::Color> pixels(4);
+
+	EXPECT_THROW(image.update({{2, 0}, {2, 2}}, pixels.data()), std::runtime_error);
+	EXPECT_THROW(image.update({{-1, 0}, {2, 2}}, pixels.data()), std::runtime_error);
+	EXPECT_THROW(image.update({{0, 1}, {2, 2}}, pixels.data()), std::runtime_error);
+}
+
+TEST(DynamicImage, updateBeforeUpload) {
+	auto image = NAS2D::DynamicImage{{3, 2}};
+	const std::vector<NAS2D::Color> pixels{{1, 2, 3, 4}, {5, 6, 7, 8}};
+	image.update({{1, 1}, {2, 1}}, pixels.data());
+
+	EXPECT_FALSE(image.isUploaded());
+	EXPECT_EQ((NAS2D::Color{0, 0, 0, 0}), image.pixelColor({0, 1}));
+	EXPECT_EQ((NAS2D::Color{1, 2, 3, 4}), image.pixelColor({1, 1}));
+	EXPECT_EQ((NAS2D::Color{5, 6, 7, 8}), image.pixelColor({2, 1}));
+	EXPECT_EQ((NAS2D::Color{0, 0, 0, 0}), image.pixelColor({1, 0}));
+}
+
+TEST(DynamicImage, destroyAsImage) {
+	static_assert(std::has_virtual_destructor_v<NAS2D::Image>);
+	// Deleting through the base class runs the DynamicImage destructor
+	const std::unique_ptr<NAS2D::Image> image = std::make_unique<NAS2D::DynamicImage>(NAS2D::Vector{2, 2});
+	EXPECT_EQ((NAS2D::Vector{2, 2}), image->size());
+}
@@ -0,0 +1,63 @@
+#include "NAS2D/Resource/GlyphCache.h"
+
+#include <gtest/gtest.h>
+
+
+namespace {
+	std::vector<NAS2D::GlyphBitmap> testGlyphs() {
+		NAS2D::Font::GlyphMetrics metrics;
+		metrics.minX = -1;
+		metrics.maxX = 3;
+		metrics.maxY = 7;
+		metrics.advance = 4;
+		metrics.drawBounds = {{-1, 2}, {2, 3}};
+
+		NAS2D::Font::GlyphMetrics spaceMetrics;
+		spaceMetrics.advance = 3;
+
+		return {
+			{U'A', metrics, {1, 2, 3, 4, 5, 6}},
+			{U' ', spaceMetrics, {}},
+		};
+	}
+}
+
+
+TEST(GlyphCache, fileName) {
+	EXPECT_EQ("00000000000000ab-12.glyphs", (NAS2D::GlyphCacheKey{0xAB, 12}.fileName()));
+	EXPECT_EQ("00000000000000ab-12-sdf.glyphs", (NAS2D::GlyphCacheKey{0xAB, 12, true}.fileName()));
+}
+
+TEST(GlyphCache, roundTrip) {
+	const auto key = NAS2D::GlyphCacheKey{0x0123456789ABCDEF, 12};
+	const auto data = NAS2D::serializeGlyphCache(key, testGlyphs());
+	const auto glyphs = NAS2D::deserializeGlyphCache(key, data);
+
+	ASSERT_EQ(2u, glyphs.size());
+	EXPECT_EQ(U'A', glyphs[0].codepoint);
+	EXPECT_EQ(-1, glyphs[0].metrics.minX);
+	EXPECT_EQ(4, glyphs[0].metrics.advance);
+	EXPECT_EQ((NAS2D::Rectangle<int>{{-1, 2}, {2, 3}}), glyphs[0].metrics.drawBounds);
+	EXPECT_EQ((std::vector<uint8_t>{1, 2, 3, 4, 5, 6}), glyphs[0].alpha);
+	EXPECT_EQ(U' ', glyphs[1].codepoint);
+	EXPECT_EQ(3, glyphs[1].metrics.advance);
+	EXPECT_TRUE(glyphs[1].alpha.empty());
+}
+
+TEST(GlyphCache, keyMismatch) {
+	const auto key = NAS2D::GlyphCacheKey{0x0123456789ABCDEF, 12};
+	const auto data = NAS2D::serializeGlyphCache(key, testGlyphs());
+
+	EXPECT_TRUE((NAS2D::deserializeGlyphCache({0x0123456789ABCDEF, 14}, data).empty()));
+	EXPECT_TRUE((NAS2D::deserializeGlyphCache({0x0123456789ABCDEE, 12}, data).empty()));
+	EXPECT_TRUE((NAS2D::deserializeGlyphCache({0x0123456789ABCDEF, 12, true}, data).empty()));
+}
+
+TEST(GlyphCache, corruptData) {
+	const auto key = NAS2D::GlyphCacheKey{0x0123456789ABCDEF, 12};
+	const auto data = NAS2D::serializeGlyphCache(key, testGlyphs());
+
+	EXPECT_TRUE(NAS2D::deserializeGlyphCache(key, "").empty());
+	EXPECT_TRUE(NAS2D::deserializeGlyphCache(key, data.substr(0, data.size() - 1)).empty());
+	EXPECT_TRUE(NAS2D::deserializeGlyphCache(key, data + "x").empty());
+}
@@ -2,6 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <stdexcept>
+#include <vector>
+
 
 TEST(Image, size) {
 	{
@@ -20,3 +23,134 @@ TEST(Image, size) {
 		EXPECT_EQ((NAS2D::Vector{1, 2}), image.size());
 	}
 }
+
+TEST(Image, pixels) {
+	uint32_t buffer[3 * 2]{0x00FF0000, 0x0000FF00, 0x000000FF, 0x00FFFFFF, 0x00000000, 0x00808080};
+	const auto image = NAS2D::Image{&buffer, 4, {3, 2}};
+
+	const auto pixels = image.pixels();
+	EXPECT_EQ((NAS2D::Vector{3, 2}), pixels.size());
+	for (int y = 0; y < 2; ++y) {
+		for (int x = 0; x < 3; ++x) {
+			EXPECT_EQ(image.pixelColor({x, y}), (pixels[{x, y}]));
+			EXPECT_EQ(image.pixelColor({x, y}), pixels.row(y)[static_cast<std::size_t>(x)]);
+		}
+	}
+}
+
+TEST(Image, pixelColorByteOrder) {
+	{
+		uint8_t buffer[4 * 1]{0x10, 0x20, 0x30, 0x40};
+		const auto image = NAS2D::Image{&buffer, 4, {1, 1}};
+		EXPECT_EQ((NAS2D::Color{0x10, 0x20, 0x30, 0x40}), image.pixelColor({0, 0}));
+		EXPECT_EQ((NAS2D::Color{0x10, 0x20, 0x30, 0x40}), (image.pixels()[{0, 0}]));
+	}
+	{
+		uint8_t buffer[3 * 2]{0x10, 0x20, 0x30, 0x40, 0x50, 0x60};
+		const auto image = NAS2D::Image{&buffer, 3, {2, 1}};
+		EXPECT_EQ((NAS2D::Color{0x40, 0x50, 0x60, 0xFF}), image.pixelColor({1, 0}));
+		EXPECT_EQ((NAS2D::Color{0x40, 0x50, 0x60, 0xFF}), (image.pixels()[{1, 0}]));
+	}
+}
+
+TEST(Image, pixelsCopy) {
+	uint32_t buffer[3 * 2]{0x00FF0000, 0x0000FF00, 0x000000FF, 0x00FFFFFF, 0x00000000, 0x00808080};
+	const auto image = NAS2D::Image{&buffer, 4, {3, 2}};
+	const auto pixels = image.pixels();
+
+	std::vector<NAS2D::Color> row(3);
+	pixels.copyRow(1, row);
+	EXPECT_EQ((std::vector{image.pixelColor({0, 1}), image.pixelColor({1, 1}), image.pixelColor({2, 1})}), row);
+
+	std::vector<NAS2D::Color> rect(2 * 2);
+	pixels.copyRect({{1, 0}, {2, 2}}, rect);
+	EXPECT_EQ((std::vector{image.pixelColor({1, 0}), image.pixelColor({2, 0}), image.pixelColor({1, 1}), image.pixelColor({2, 1})}), rect);
+
+	std::vector<uint8_t> red(2);
+	pixels.copyChannel({{0, 0}, {2, 1}}, NAS2D::ColorChannel::Red, red);
+	EXPECT_EQ((std::vector<uint8_t>{image.pixelColor({0, 0}).red, image.pixelColor({1, 0}).red}), red);
+
+	EXPECT_THROW(pixels.copyRow(2, row), std::runtime_error);
+	EXPECT_THROW(pixels.copyRect({{2, 0}, {2, 2}}, rect), std::runtime_error);
+	EXPECT_THROW(pixels.copyRect({{0, 0}, {1, 1}}, rect), std::runtime_error);
+}
+
+TEST(Image, retainedSurfaceBytes) {
+	const auto initialBytes = NAS2D::Image::retainedSurfaceBytes();
+	{
+		uint32_t buffer[4 * 2]{};
+		const auto image = NAS2D::Image{&buffer, 4, {4, 2}};
+		EXPECT_EQ(initialBytes + sizeof(buffer), NAS2D::Image::retainedSurfaceBytes());
+	}
+	EXPECT_EQ(initialBytes, NAS2D::Image::retainedSurfaceBytes());
+}
+
+TEST(Image, surfaceRetention) {
+	uint32_t buffer[1]{};
+	const auto keepImage = NAS2D::Image{&buffer, 4, {1, 1}};
+	EXPECT_EQ(NAS2D::Image::SurfaceRetention::Keep, keepImage.surfaceRetention());
+
+	NAS2D::Image::setDefaultSurfaceRetention(NAS2D::Image::SurfaceRetention::Release);
+	auto releaseImage = NAS2D::Image{&buffer, 4, {1, 1}};
+	NAS2D::Image::setDefaultSurfaceRetention(NAS2D::Image::SurfaceRetention::Keep);
+	EXPECT_EQ(NAS2D::Image::SurfaceRetention::Release, releaseImage.surfaceRetention());
+
+	releaseImage.setSurfaceRetention(NAS2D::Image::SurfaceRetention::AlphaMask);
+	EXPECT_EQ(NAS2D::Image::SurfaceRetention::AlphaMask, releaseImage.surfaceRetention());
+	// Pixels stay readable until the image is uploaded
+	EXPECT_EQ(releaseImage.pixelColor({0, 0}).alpha, releaseImage.pixelAlpha({0, 0}));
+}
+
+TEST(Image, textureFormat) {
+	uint32_t buffer[1]{};
+	const auto defaultImage = NAS2D::Image{&buffer, 4, {1, 1}};
+	EXPECT_EQ(NAS2D::Image::TextureFormat::Rgba8, defaultImage.textureFormat());
+	EXPECT_FALSE(defaultImage.isDithered());
+
+	NAS2D::Image::setDefaultTextureFormat(NAS2D::Image::TextureFormat::Rgb565);
+	auto compactImage = NAS2D::Image{&buffer, 4, {1, 1}};
+	NAS2D::Image::setDefaultTextureFormat(NAS2D::Image::TextureFormat::Rgba8);
+	EXPECT_EQ(NAS2D::Image::TextureFormat::Rgb565, compactImage.textureFormat());
+
+	compactImage.setTextureFormat(NAS2D::Image::TextureFormat::Rgba4444, true);
+	EXPECT_EQ(NAS2D::Image::TextureFormat::Rgba4444, compactImage.textureFormat());
+	EXPECT_TRUE(compactImage.isDithered());
+	// Nothing is saved until the texture exists
+	EXPECT_EQ(0u, NAS2D::Image::compactTextureBytesSaved());
+}
+
+TEST(Image, pixelsOpaqueBounds) {
+	// Colors spell out the alpha byte, independent of byte order
+	constexpr NAS2D::Color Clear{0, 0, 0, 0};
+	NAS2D::Color buffer[4 * 3]{
+		Clear, Clear, Clear, Clear,
+		Clear, {0, 0, 0, 0x10}, Clear, Clear,
+		Clear, Clear, {0, 0, 0, 0xFF}, Clear,
+	};
+	const auto image = NAS2D::Image{&buffer, 4, {4, 3}};
+	const auto pixels = image.pixels();
+
+	EXPECT_EQ((NAS2D::Rectangle<int>{{1, 1}, {2, 2}}), pixels.opaqueBounds({{0, 0}, {4, 3}}));
+	EXPECT_EQ((NAS2D::Rectangle<int>{{2, 2}, {1, 1}}), pixels.opaqueBounds({{0, 0}, {4, 3}}, 0x10));
+	EXPECT_EQ((NAS2D::Rectangle<int>{{2, 2}, {1, 1}}), pixels.opaqueBounds({{2, 0}, {2, 3}}));
+	EXPECT_EQ((NAS2D::Rectangle<int>{{3, 0}, {0, 0}}), pixels.opaqueBounds({{3, 0}, {1, 3}}));
+	EXPECT_THROW(pixels.opaqueBounds({{3, 0}, {2, 3}}), std::runtime_error);
+}
+
+TEST(Image, isOpaque) {
+	NAS2D::Color opaqueBuffer[2 * 1]{{255, 0, 0, 255}, {255, 255, 255, 255}};
+	const auto opaqueImage = NAS2D::Image{&opaqueBuffer, 4, {2, 1}};
+	EXPECT_TRUE(opaqueImage.isOpaque());
+
+	// Buffers without alpha are always opaque
+	uint8_t rgbBuffer[3 * 2]{255, 0, 0, 0, 0, 0};
+	const auto rgbImage = NAS2D::Image{&rgbBuffer, 3, {2, 1}};
+	EXPECT_TRUE(rgbImage.isOpaque());
+
+	NAS2D::Color translucentBuffer[2 * 1]{{255, 0, 0, 255}, {255, 255, 255, 128}};
+	auto translucentImage = NAS2D::Image{&translucentBuffer, 4, {2, 1}};
+	EXPECT_FALSE(translucentImage.isOpaque());
+
+	translucentImage.setTextureFormat(NAS2D::Image::TextureFormat::Rgb565);
+	EXPECT_TRUE(translucentImage.isOpaque());
+}
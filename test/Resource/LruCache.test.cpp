@@ -0,0 +1,90 @@
+#include "NAS2D/Resource/LruCache.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+
+TEST(LruCache, findAndEmplace) {
+	NAS2D::LruCache<std::string, int> cache{10};
+
+	EXPECT_EQ(nullptr, cache.find("a"));
+	EXPECT_EQ(1u, cache.misses());
+
+	EXPECT_EQ(1, cache.emplace("a", 1, 1));
+	ASSERT_NE(nullptr, cache.find("a"));
+	EXPECT_EQ(1, *cache.find("a"));
+	EXPECT_EQ(2u, cache.hits());
+	EXPECT_EQ(1u, cache.misses());
+
+	EXPECT_EQ(1u, cache.size());
+	EXPECT_EQ(1u, cache.usage());
+}
+
+TEST(LruCache, emplaceReplacesExisting) {
+	NAS2D::LruCache<std::string, int> cache{10};
+
+	cache.emplace("a", 4, 1);
+	cache.emplace("a", 2, 2);
+
+	EXPECT_EQ(1u, cache.size());
+	EXPECT_EQ(2u, cache.usage());
+	EXPECT_EQ(2, *cache.find("a"));
+}
+
+TEST(LruCache, evictsLeastRecentlyUsed) {
+	NAS2D::LruCache<std::string, int> cache{3};
+
+	cache.emplace("a", 1, 1);
+	cache.emplace("b", 1, 2);
+	cache.emplace("c", 1, 3);
+	// Mark "a" as recently used, leaving "b" as least recently used
+	cache.find("a");
+	cache.emplace("d", 1, 4);
+
+	EXPECT_EQ(1u, cache.evictions());
+	EXPECT_EQ(nullptr, cache.find("b"));
+	EXPECT_NE(nullptr, cache.find("a"));
+	EXPECT_NE(nullptr, cache.find("c"));
+	EXPECT_NE(nullptr, cache.find("d"));
+}
+
+TEST(LruCache, oversizedEntryIsKept) {
+	NAS2D::LruCache<std::string, int> cache{3};
+
+	cache.emplace("a", 1, 1);
+	cache.emplace("b", 5, 2);
+
+	EXPECT_EQ(1u, cache.size());
+	EXPECT_EQ(5u, cache.usage());
+	EXPECT_NE(nullptr, cache.find("b"));
+}
+
+TEST(LruCache, capacity) {
+	NAS2D::LruCache<std::string, int> cache{4};
+
+	cache.emplace("a", 2, 1);
+	cache.emplace("b", 2, 2);
+	cache.capacity(2);
+
+	EXPECT_EQ(2u, cache.capacity());
+	EXPECT_EQ(1u, cache.size());
+	EXPECT_NE(nullptr, cache.find("b"));
+}
+
+TEST(LruCache, eraseIf) {
+	NAS2D::LruCache<std::string, int> cache{10};
+
+	cache.emplace("a1", 1, 1);
+	cache.emplace("b1", 2, 2);
+	cache.emplace("a2", 3, 3);
+	cache.eraseIf([](const std::string& key) { return key[0] == 'a'; });
+
+	EXPECT_EQ(1u, cache.size());
+	EXPECT_EQ(2u, cache.usage());
+	EXPECT_NE(nullptr, cache.find("b1"));
+
+	cache.clear();
+	EXPECT_EQ(0u, cache.size());
+	EXPECT_EQ(0u, cache.usage());
+}
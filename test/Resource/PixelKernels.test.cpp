@@ -0,0 +1,361 @@
+#include "NAS2D/Resource/PixelKernels.h"
+
+#include <gtest/gtest.h>
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+
+namespace {
+	std::vector<NAS2D::Color> testPixels(std::size_t count) {
+		std::vector<NAS2D::Color> pixels;
+		for (std::size_t i = 0; i < count; ++i) {
+			const auto value = static_cast<uint8_t>(i * 4);
+			pixels.push_back({value, static_cast<uint8_t>(value + 1), static_cast<uint8_t>(value + 2), static_cast<uint8_t>(255 - value)});
+		}
+		return pixels;
+	}
+
+
+	template <typename Function>
+	double averageMilliseconds(Function function) {
+		constexpr int runCount = 20;
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < runCount; ++i) {
+			function();
+		}
+		const auto elapsed = std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - start};
+		return elapsed.count() / runCount;
+	}
+
+
+	// Converts a 1024x1024 surface with SDL, and the same pixels with a kernel
+	template <typename Kernel>
+	void compareWithSdl(const char* name, int bitsPerPixel, uint32_t sourceFormat, Kernel kernel) {
+		constexpr int size = 1024;
+		constexpr auto pixelCount = std::size_t{size} * std::size_t{size};
+		const auto bytesPerPixel = static_cast<std::size_t>(bitsPerPixel / 8);
+
+		std::vector<uint8_t> source(pixelCount * bytesPerPixel);
+		for (std::size_t i = 0; i < source.size(); ++i) {
+			source[i] = static_cast<uint8_t>(i * 7);
+		}
+		std::vector<NAS2D::Color> destination(pixelCount);
+
+		auto* surface = SDL_CreateRGBSurfaceWithFormatFrom(source.data(), size, size, bitsPerPixel, size * bitsPerPixel / 8, sourceFormat);
+		ASSERT_NE(nullptr, surface);
+		if (surface->format->palette) {
+			for (int i = 0; i < surface->format->palette->ncolors; ++i) {
+				surface->format->palette->colors[i] = {static_cast<uint8_t>(i), static_cast<uint8_t>(i), static_cast<uint8_t>(i), 255};
+			}
+		}
+
+		const auto sdlTime = averageMilliseconds([surface]() { SDL_FreeSurface(SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0)); });
+		const auto kernelTime = averageMilliseconds([&]() { kernel(source.data(), destination.data(), pixelCount); });
+		SDL_FreeSurface(surface);
+
+		std::cout << name << ": SDL " << sdlTime << " ms, kernel " << kernelTime << " ms" << std::endl;
+	}
+}
+
+
+TEST(PixelKernels, extractChannelScalar) {
+	const auto pixels = testPixels(3);
+	std::vector<uint8_t> channel(pixels.size());
+
+	NAS2D::extractChannelScalar(pixels.data(), channel.data(), pixels.size(), NAS2D::ColorChannel::Red);
+	EXPECT_EQ((std::vector<uint8_t>{0, 4, 8}), channel);
+	NAS2D::extractChannelScalar(pixels.data(), channel.data(), pixels.size(), NAS2D::ColorChannel::Green);
+	EXPECT_EQ((std::vector<uint8_t>{1, 5, 9}), channel);
+	NAS2D::extractChannelScalar(pixels.data(), channel.data(), pixels.size(), NAS2D::ColorChannel::Blue);
+	EXPECT_EQ((std::vector<uint8_t>{2, 6, 10}), channel);
+	NAS2D::extractChannelScalar(pixels.data(), channel.data(), pixels.size(), NAS2D::ColorChannel::Alpha);
+	EXPECT_EQ((std::vector<uint8_t>{255, 251, 247}), channel);
+}
+
+TEST(PixelKernels, extractChannelMatchesScalar) {
+	// Lengths either side of the 16 pixel SIMD block size
+	for (const std::size_t count : {0u, 1u, 15u, 16u, 17u, 33u, 64u}) {
+		const auto pixels = testPixels(count);
+		for (const auto channel : {NAS2D::ColorChannel::Red, NAS2D::ColorChannel::Green, NAS2D::ColorChannel::Blue, NAS2D::ColorChannel::Alpha}) {
+			std::vector<uint8_t> expected(count);
+			std::vector<uint8_t> actual(count);
+			NAS2D::extractChannelScalar(pixels.data(), expected.data(), count, channel);
+			NAS2D::extractChannel(pixels.data(), actual.data(), count, channel);
+			EXPECT_EQ(expected, actual);
+		}
+	}
+}
+
+TEST(PixelKernels, expandRgbToRgbaScalar) {
+	const std::vector<uint8_t> rgb{1, 2, 3, 4, 5, 6};
+	std::vector<NAS2D::Color> pixels(2);
+	NAS2D::expandRgbToRgbaScalar(rgb.data(), pixels.data(), pixels.size());
+	EXPECT_EQ((std::vector<NAS2D::Color>{{1, 2, 3, 255}, {4, 5, 6, 255}}), pixels);
+}
+
+TEST(PixelKernels, expandPaletteScalar) {
+	std::vector<NAS2D::Color> palette(256, NAS2D::Color::Black);
+	palette[1] = NAS2D::Color::Red;
+	palette[255] = NAS2D::Color{1, 2, 3, 0};
+	const std::vector<uint8_t> indices{0, 1, 255};
+	std::vector<NAS2D::Color> pixels(indices.size());
+	NAS2D::expandPaletteScalar(indices.data(), palette.data(), pixels.data(), pixels.size());
+	EXPECT_EQ((std::vector<NAS2D::Color>{NAS2D::Color::Black, NAS2D::Color::Red, {1, 2, 3, 0}}), pixels);
+}
+
+TEST(PixelKernels, swizzleBgraToRgbaScalar) {
+	std::vector<NAS2D::Color> pixels{{1, 2, 3, 4}};
+	NAS2D::swizzleBgraToRgbaScalar(pixels.data(), pixels.data(), pixels.size());
+	EXPECT_EQ((std::vector<NAS2D::Color>{{3, 2, 1, 4}}), pixels);
+}
+
+TEST(PixelKernels, premultiplyAlphaScalar) {
+	std::vector<NAS2D::Color> pixels{{255, 128, 0, 255}, {255, 128, 1, 128}, {200, 100, 50, 0}};
+	NAS2D::premultiplyAlphaScalar(pixels.data(), pixels.size());
+	EXPECT_EQ((std::vector<NAS2D::Color>{{255, 128, 0, 255}, {128, 64, 1, 128}, {0, 0, 0, 0}}), pixels);
+}
+
+TEST(PixelKernels, fillAlpha) {
+	std::vector<NAS2D::Color> pixels{{1, 2, 3, 4}, {5, 6, 7, 8}};
+	NAS2D::fillAlpha(pixels.data(), pixels.size(), 255);
+	EXPECT_EQ((std::vector<NAS2D::Color>{{1, 2, 3, 255}, {5, 6, 7, 255}}), pixels);
+}
+
+TEST(PixelKernels, allOpaque) {
+	// Each length is tested with every pixel opaque, then with one translucent pixel at each index
+	for (std::size_t count = 0; count <= 40; ++count) {
+		std::vector<NAS2D::Color> pixels(count, NAS2D::Color{1, 2, 3, 255});
+		EXPECT_TRUE(NAS2D::allOpaque(pixels.data(), pixels.size()));
+		EXPECT_TRUE(NAS2D::allOpaqueScalar(pixels.data(), pixels.size()));
+
+		for (std::size_t i = 0; i < count; ++i) {
+			pixels[i].alpha = 254;
+			EXPECT_FALSE(NAS2D::allOpaque(pixels.data(), pixels.size())) << count << ", " << i;
+			EXPECT_FALSE(NAS2D::allOpaqueScalar(pixels.data(), pixels.size())) << count << ", " << i;
+			pixels[i].alpha = 255;
+		}
+	}
+}
+
+TEST(PixelKernels, conversionsMatchScalar) {
+	// Lengths either side of the 4, 8 and 16 pixel SIMD block sizes
+	for (const std::size_t count : {0u, 1u, 3u, 4u, 7u, 8u, 15u, 16u, 17u, 33u, 64u}) {
+		const auto pixels = testPixels(count);
+		std::vector<uint8_t> bytes(count * 3);
+		for (std::size_t i = 0; i < bytes.size(); ++i) {
+			bytes[i] = static_cast<uint8_t>(i * 7);
+		}
+
+		std::vector<NAS2D::Color> expected(count);
+		std::vector<NAS2D::Color> actual(count);
+
+		NAS2D::expandRgbToRgbaScalar(bytes.data(), expected.data(), count);
+		NAS2D::expandRgbToRgba(bytes.data(), actual.data(), count);
+		EXPECT_EQ(expected, actual);
+
+		const auto palette = testPixels(256);
+		NAS2D::expandPaletteScalar(bytes.data(), palette.data(), expected.data(), count);
+		NAS2D::expandPalette(bytes.data(), palette.data(), actual.data(), count);
+		EXPECT_EQ(expected, actual);
+
+		NAS2D::swizzleBgraToRgbaScalar(pixels.data(), expected.data(), count);
+		NAS2D::swizzleBgraToRgba(pixels.data(), actual.data(), count);
+		EXPECT_EQ(expected, actual);
+
+		expected = pixels;
+		actual = pixels;
+		NAS2D::premultiplyAlphaScalar(expected.data(), count);
+		NAS2D::premultiplyAlpha(actual.data(), count);
+		EXPECT_EQ(expected, actual);
+	}
+}
+
+TEST(PixelKernels, premultiplyAlphaAllValues) {
+	std::vector<NAS2D::Color> pixels;
+	for (unsigned int alpha = 0; alpha < 256; ++alpha) {
+		for (unsigned int value = 0; value < 256; ++value) {
+			pixels.push_back({static_cast<uint8_t>(value), static_cast<uint8_t>(255 - value), static_cast<uint8_t>(value), static_cast<uint8_t>(alpha)});
+		}
+	}
+	auto expected = pixels;
+	for (auto& color : expected) {
+		const auto scale = [alpha = color.alpha](uint8_t value) { return static_cast<uint8_t>((value * alpha * 2 + 255) / 510); };
+		color = {scale(color.red), scale(color.green), scale(color.blue), color.alpha};
+	}
+
+	NAS2D::premultiplyAlpha(pixels.data(), pixels.size());
+	EXPECT_EQ(expected, pixels);
+}
+
+
+TEST(PixelKernels, downsampledSize) {
+	EXPECT_EQ((NAS2D::Vector{4, 2}), NAS2D::downsampledSize({8, 4}));
+	EXPECT_EQ((NAS2D::Vector{2, 1}), NAS2D::downsampledSize({5, 3}));
+	EXPECT_EQ((NAS2D::Vector{1, 1}), NAS2D::downsampledSize({1, 1}));
+	EXPECT_EQ((NAS2D::Vector{2, 1}), NAS2D::downsampledSize({4, 1}));
+}
+
+TEST(PixelKernels, downsample2xScalar) {
+	const std::vector<NAS2D::Color> pixels{
+		{0, 0, 0, 0}, {4, 8, 12, 255}, {10, 10, 10, 10},
+		{8, 8, 8, 8}, {4, 0, 0, 1}, {20, 20, 20, 20},
+	};
+	std::vector<NAS2D::Color> result(1);
+	NAS2D::downsample2xScalar(pixels.data(), {3, 2}, result.data());
+	EXPECT_EQ((std::vector<NAS2D::Color>{{4, 4, 5, 66}}), result);
+
+	// Odd last row is repeated
+	std::vector<NAS2D::Color> column(1);
+	NAS2D::downsample2xScalar(pixels.data(), {1, 1}, column.data());
+	EXPECT_EQ((std::vector<NAS2D::Color>{{0, 0, 0, 0}}), column);
+}
+
+TEST(PixelKernels, downsample2xMatchesScalar) {
+	for (const auto size : {NAS2D::Vector{1, 1}, NAS2D::Vector{2, 2}, NAS2D::Vector{3, 5}, NAS2D::Vector{8, 4}, NAS2D::Vector{9, 7}, NAS2D::Vector{17, 2}, NAS2D::Vector{64, 64}}) {
+		const auto pixels = testPixels(static_cast<std::size_t>(size.x * size.y));
+		const auto resultSize = NAS2D::downsampledSize(size);
+		std::vector<NAS2D::Color> expected(static_cast<std::size_t>(resultSize.x * resultSize.y));
+		std::vector<NAS2D::Color> actual(expected.size());
+		NAS2D::downsample2xScalar(pixels.data(), size, expected.data());
+		NAS2D::downsample2x(pixels.data(), size, actual.data());
+		EXPECT_EQ(expected, actual);
+	}
+}
+
+TEST(PixelKernels, quantizeRgb565Scalar) {
+	const std::vector<NAS2D::Color> pixels{{255, 255, 255, 0}, {0, 0, 0, 255}, {255, 0, 0, 255}, {0, 255, 0, 255}, {0, 0, 255, 255}, {4, 2, 4, 255}, {3, 1, 3, 255}};
+	std::vector<uint16_t> result(pixels.size());
+	NAS2D::quantizeRgb565Scalar(pixels.data(), result.data(), pixels.size(), std::nullopt);
+	EXPECT_EQ((std::vector<uint16_t>{0xFFFF, 0x0000, 0xF800, 0x07E0, 0x001F, 0x0821, 0x0000}), result);
+}
+
+TEST(PixelKernels, quantizeRgba4444Scalar) {
+	const std::vector<NAS2D::Color> pixels{{255, 0, 0, 255}, {0x88, 0x10, 0x07, 0x08}, {255, 255, 255, 255}};
+	std::vector<uint16_t> result(pixels.size());
+	NAS2D::quantizeRgba4444Scalar(pixels.data(), result.data(), pixels.size(), std::nullopt);
+	EXPECT_EQ((std::vector<uint16_t>{0xF00F, 0x9101, 0xFFFF}), result);
+}
+
+TEST(PixelKernels, quantizeDitherKeepsAverage) {
+	// 100 falls between the 4 bit levels 96 and 112, a quarter of the way up
+	const std::vector<NAS2D::Color> pixels(4, NAS2D::Color{100, 100, 100, 100});
+	std::vector<uint16_t> result(pixels.size());
+	int levelSum = 0;
+	for (int row = 0; row < 4; ++row) {
+		NAS2D::quantizeRgba4444Scalar(pixels.data(), result.data(), pixels.size(), row);
+		for (const auto value : result) {
+			levelSum += value >> 12;
+		}
+	}
+	EXPECT_EQ(6 * 16 + 4, levelSum);
+}
+
+TEST(PixelKernels, quantizeMatchesScalar) {
+	for (const auto count : {std::size_t{0}, std::size_t{1}, std::size_t{7}, std::size_t{8}, std::size_t{13}, std::size_t{64}, std::size_t{67}}) {
+		const auto pixels = testPixels(count);
+		for (const auto ditherRow : {std::optional<int>{}, std::optional<int>{0}, std::optional<int>{1}, std::optional<int>{6}}) {
+			std::vector<uint16_t> expected(count);
+			std::vector<uint16_t> actual(count);
+			NAS2D::quantizeRgb565Scalar(pixels.data(), expected.data(), count, ditherRow);
+			NAS2D::quantizeRgb565(pixels.data(), actual.data(), count, ditherRow);
+			EXPECT_EQ(expected, actual);
+			NAS2D::quantizeRgba4444Scalar(pixels.data(), expected.data(), count, ditherRow);
+			NAS2D::quantizeRgba4444(pixels.data(), actual.data(), count, ditherRow);
+			EXPECT_EQ(expected, actual);
+		}
+	}
+}
+
+TEST(PixelKernels, packThresholdBitsScalar) {
+	const std::vector<uint8_t> values{0, 10, 11, 255, 10, 200};
+	std::vector<uint64_t> result(1, ~uint64_t{0});
+	NAS2D::packThresholdBitsScalar(values.data(), result.data(), values.size(), 10);
+	EXPECT_EQ((std::vector<uint64_t>{0b101100}), result);
+}
+
+TEST(PixelKernels, packThresholdBitsMatchesScalar) {
+	for (const auto count : {std::size_t{0}, std::size_t{5}, std::size_t{64}, std::size_t{100}, std::size_t{128}, std::size_t{200}}) {
+		std::vector<uint8_t> values(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			values[i] = static_cast<uint8_t>(i * 37);
+		}
+		for (const auto threshold : {uint8_t{0}, uint8_t{127}, uint8_t{128}, uint8_t{255}}) {
+			std::vector<uint64_t> expected((count + 63) / 64);
+			std::vector<uint64_t> actual(expected.size());
+			NAS2D::packThresholdBitsScalar(values.data(), expected.data(), count, threshold);
+			NAS2D::packThresholdBits(values.data(), actual.data(), count, threshold);
+			EXPECT_EQ(expected, actual);
+		}
+	}
+}
+
+TEST(PixelKernels, anyBitsOverlapScalar) {
+	const std::vector<uint64_t> bits{0b1000, 0};
+	EXPECT_TRUE(NAS2D::anyBitsOverlapScalar(bits.data(), std::vector<uint64_t>{0, 0b1000, 0}.data(), 2, 0));
+	EXPECT_TRUE(NAS2D::anyBitsOverlapScalar(bits.data(), std::vector<uint64_t>{0, 0b10, 0}.data(), 2, 2));
+	EXPECT_FALSE(NAS2D::anyBitsOverlapScalar(bits.data(), std::vector<uint64_t>{0, 0b10, 0}.data(), 2, 1));
+	// High bits of the previous word are carried into the next
+	EXPECT_TRUE(NAS2D::anyBitsOverlapScalar(bits.data(), std::vector<uint64_t>{uint64_t{1} << 62, 0, 0}.data(), 1, 5));
+}
+
+TEST(PixelKernels, anyBitsOverlapMatchesScalar) {
+	std::vector<uint64_t> bits(9);
+	std::vector<uint64_t> shiftedBits(bits.size() + 1);
+	for (std::size_t position = 0; position < bits.size() * 64; position += 29) {
+		std::fill(bits.begin(), bits.end(), 0);
+		bits[position / 64] = uint64_t{1} << (position % 64);
+		for (std::size_t other = 0; other < shiftedBits.size() * 64; other += 13) {
+			std::fill(shiftedBits.begin(), shiftedBits.end(), 0);
+			shiftedBits[other / 64] = uint64_t{1} << (other % 64);
+			for (const auto bitShift : {0u, 1u, 31u, 63u}) {
+				for (const auto count : {std::size_t{1}, std::size_t{4}, std::size_t{9}}) {
+					EXPECT_EQ(NAS2D::anyBitsOverlapScalar(bits.data(), shiftedBits.data(), count, bitShift), NAS2D::anyBitsOverlap(bits.data(), shiftedBits.data(), count, bitShift));
+				}
+			}
+		}
+	}
+}
+
+// Timing comparisons, not run by default. Run with:
+// --gtest_also_run_disabled_tests --gtest_filter=PixelKernelsBenchmark.*
+TEST(PixelKernelsBenchmark, DISABLED_expandRgbToRgba) {
+	compareWithSdl("RGB24 to RGBA32", 24, SDL_PIXELFORMAT_RGB24, [](const uint8_t* source, NAS2D::Color* destination, std::size_t count) {
+		NAS2D::expandRgbToRgba(source, destination, count);
+	});
+}
+
+TEST(PixelKernelsBenchmark, DISABLED_expandPalette) {
+	const auto palette = testPixels(256);
+	compareWithSdl("INDEX8 to RGBA32", 8, SDL_PIXELFORMAT_INDEX8, [&palette](const uint8_t* source, NAS2D::Color* destination, std::size_t count) {
+		NAS2D::expandPalette(source, palette.data(), destination, count);
+	});
+}
+
+TEST(PixelKernelsBenchmark, DISABLED_swizzleBgraToRgba) {
+	compareWithSdl("BGRA32 to RGBA32", 32, SDL_PIXELFORMAT_BGRA32, [](const uint8_t* source, NAS2D::Color* destination, std::size_t count) {
+		NAS2D::swizzleBgraToRgba(reinterpret_cast<const NAS2D::Color*>(source), destination, count);
+	});
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+TEST(PixelKernelsBenchmark, DISABLED_premultiplyAlpha) {
+	constexpr int size = 1024;
+	auto pixels = testPixels(std::size_t{size} * std::size_t{size});
+	auto destination = pixels;
+
+	const auto sdlTime = averageMilliseconds([&]() {
+		SDL_PremultiplyAlpha(size, size, SDL_PIXELFORMAT_RGBA32, pixels.data(), size * 4, SDL_PIXELFORMAT_RGBA32, destination.data(), size * 4);
+	});
+	const auto kernelTime = averageMilliseconds([&]() {
+		std::copy(pixels.begin(), pixels.end(), destination.begin());
+		NAS2D::premultiplyAlpha(destination.data(), destination.size());
+	});
+
+	std::cout << "Premultiply RGBA32: SDL " << sdlTime << " ms, kernel " << kernelTime << " ms" << std::endl;
+}
+#endif
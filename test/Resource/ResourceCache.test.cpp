@@ -48,3 +48,76 @@ TEST(ResourceCache, load) {
 	EXPECT_NO_THROW(cache.clear());
 	EXPECT_EQ(0u, cache.size());
 }
+
+TEST(ResourceCache, shareIdenticalContent) {
+	struct MockResource {
+		explicit MockResource(const std::string& initString) :
+			string{initString}
+		{}
+
+		std::string string;
+	};
+
+	NAS2D::ResourceCache<MockResource, std::string> cache;
+	// Content of names differing only by a path is identical
+	cache.shareIdenticalContent(
+		[](const std::string& name) { return uint64_t{std::hash<std::string>{}(name.substr(name.find('/') + 1))}; },
+		[](const MockResource& resource) { return resource.string.size(); }
+	);
+
+	const auto& value1 = cache.load("a/image");
+	const auto& value2 = cache.load("b/image");
+	const auto& value3 = cache.load("b/other");
+
+	EXPECT_EQ(&value1, &value2);
+	EXPECT_NE(&value1, &value3);
+	EXPECT_EQ("a/image", value2.string);
+	EXPECT_EQ(3u, cache.size());
+	EXPECT_EQ(1u, cache.sharedCount());
+	EXPECT_EQ(7u, cache.sharedBytes());
+
+	// Shared resource lives until its last key is unloaded
+	cache.unload("a/image");
+	EXPECT_EQ("a/image", cache.load("b/image").string);
+	cache.unload("b/image");
+	EXPECT_EQ("c/image", cache.load("c/image").string);
+	EXPECT_EQ(1u, cache.sharedCount());
+}
+
+TEST(ResourceCache, shareIdenticalContentHashCollision) {
+	struct MockResource {
+		explicit MockResource(const std::string& initString) :
+			string{initString}
+		{}
+
+		std::string string;
+	};
+
+	NAS2D::ResourceCache<MockResource, std::string> cache;
+	// Every name collides, only names differing by a path have the same content
+	cache.shareIdenticalContent(
+		[](const std::string&) { return uint64_t{0}; },
+		{},
+		[](const auto& key1, const auto& key2) {
+			const auto& name1 = std::get<0>(key1);
+			const auto& name2 = std::get<0>(key2);
+			return name1.substr(name1.find('/') + 1) == name2.substr(name2.find('/') + 1);
+		}
+	);
+
+	const auto& value1 = cache.load("a/image");
+	const auto& value2 = cache.load("b/other");
+	const auto& value3 = cache.load("c/image");
+	const auto& value4 = cache.load("d/other");
+
+	EXPECT_NE(&value1, &value2);
+	EXPECT_EQ(&value1, &value3);
+	EXPECT_EQ(&value2, &value4);
+	EXPECT_EQ(2u, cache.sharedCount());
+
+	// Content of unloaded resources is no longer matched
+	cache.unload("a/image");
+	cache.unload("c/image");
+	EXPECT_EQ("e/image", cache.load("e/image").string);
+	EXPECT_EQ(2u, cache.sharedCount());
+}
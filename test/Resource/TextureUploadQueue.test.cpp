@@ -0,0 +1,60 @@
+#include "NAS2D/Resource/TextureUploadQueue.h"
+#include "NAS2D/Resource/Image.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+
+
+TEST(TextureUploadQueue, pushCancel) {
+	uint32_t buffer1[1 * 1]{};
+	uint32_t buffer2[1 * 1]{};
+	const auto image1 = NAS2D::Image{&buffer1, 4, {1, 1}};
+	const auto image2 = NAS2D::Image{&buffer2, 4, {1, 1}};
+
+	NAS2D::TextureUploadQueue uploadQueue;
+	uploadQueue.push(image1);
+	uploadQueue.push(image2);
+	uploadQueue.push(image1);
+	EXPECT_EQ(2u, uploadQueue.size());
+
+	uploadQueue.cancel(image1);
+	EXPECT_EQ(1u, uploadQueue.size());
+	uploadQueue.cancel(image2);
+	EXPECT_TRUE(uploadQueue.empty());
+
+	// Cancelling an image that isn't queued has no effect
+	uploadQueue.cancel(image1);
+	EXPECT_TRUE(uploadQueue.empty());
+}
+
+TEST(TextureUploadQueue, destroyedImageRemovesItself) {
+	uint32_t buffer1[1 * 1]{};
+	uint32_t buffer2[1 * 1]{};
+	auto image1 = std::make_unique<NAS2D::Image>(&buffer1, 4, NAS2D::Vector{1, 1});
+	const auto image2 = NAS2D::Image{&buffer2, 4, {1, 1}};
+
+	NAS2D::TextureUploadQueue uploadQueue;
+	uploadQueue.push(*image1);
+	uploadQueue.push(image2);
+	image1.reset();
+	EXPECT_EQ(1u, uploadQueue.size());
+
+	// Uploading needs an OpenGL context, so only the remaining entry is checked
+	uploadQueue.cancel(image2);
+	EXPECT_TRUE(uploadQueue.empty());
+}
+
+TEST(TextureUploadQueue, imageOutlivesQueue) {
+	uint32_t buffer[1 * 1]{};
+	auto image = std::make_unique<NAS2D::Image>(&buffer, 4, NAS2D::Vector{1, 1});
+
+	{
+		NAS2D::TextureUploadQueue uploadQueue;
+		uploadQueue.push(*image);
+	}
+
+	// Doesn't refer to the destroyed queue
+	image.reset();
+}
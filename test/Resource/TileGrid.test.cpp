@@ -0,0 +1,82 @@
+#include "NAS2D/Resource/TileGrid.h"
+
+#include <gtest/gtest.h>
+
+
+namespace {
+	void expectRectEq(NAS2D::Rectangle<float> expected, NAS2D::Rectangle<float> actual) {
+		EXPECT_FLOAT_EQ(expected.position.x, actual.position.x);
+		EXPECT_FLOAT_EQ(expected.position.y, actual.position.y);
+		EXPECT_FLOAT_EQ(expected.size.x, actual.size.x);
+		EXPECT_FLOAT_EQ(expected.size.y, actual.size.y);
+	}
+}
+
+
+TEST(TileGrid, needsTiling) {
+	EXPECT_FALSE(NAS2D::TileGrid::needsTiling({2048, 2048}, 2048));
+	EXPECT_TRUE(NAS2D::TileGrid::needsTiling({2049, 1}, 2048));
+	EXPECT_TRUE(NAS2D::TileGrid::needsTiling({1, 2049}, 2048));
+	// Without a known limit, nothing is tiled
+	EXPECT_FALSE(NAS2D::TileGrid::needsTiling({100000, 100000}, 0));
+}
+
+TEST(TileGrid, fittedTileSize) {
+	EXPECT_EQ(1024, NAS2D::TileGrid::fittedTileSize(1024, 2048));
+	// The border on both sides must fit in the texture too
+	EXPECT_EQ(1022, NAS2D::TileGrid::fittedTileSize(1024, 1024));
+	EXPECT_EQ(1024, NAS2D::TileGrid::fittedTileSize(1024, 0));
+	EXPECT_EQ(1, NAS2D::TileGrid::fittedTileSize(1024, 2));
+}
+
+TEST(TileGrid, maxTextureSizePlusOne) {
+	constexpr int maxTextureSize{1024};
+	const auto imageSize = NAS2D::Vector{maxTextureSize + 1, maxTextureSize + 1};
+	ASSERT_TRUE(NAS2D::TileGrid::needsTiling(imageSize, maxTextureSize));
+
+	const NAS2D::TileGrid grid{imageSize, NAS2D::TileGrid::fittedTileSize(1024, maxTextureSize)};
+	EXPECT_EQ((NAS2D::Vector{2, 2}), grid.tileCount());
+
+	EXPECT_EQ((NAS2D::Rectangle<int>{{0, 0}, {1022, 1022}}), grid.tileBounds({0, 0}));
+	EXPECT_EQ((NAS2D::Rectangle<int>{{1022, 1022}, {3, 3}}), grid.tileBounds({1, 1}));
+
+	// Border on inner edges only, and every tile texture fits
+	EXPECT_EQ((NAS2D::Rectangle<int>{{0, 0}, {1023, 1023}}), grid.textureBounds({0, 0}));
+	EXPECT_EQ((NAS2D::Rectangle<int>{{1021, 1021}, {4, 4}}), grid.textureBounds({1, 1}));
+	for (int y = 0; y < 2; ++y) {
+		for (int x = 0; x < 2; ++x) {
+			const auto textureSize = grid.textureBounds({x, y}).size;
+			EXPECT_LE(textureSize.x, maxTextureSize);
+			EXPECT_LE(textureSize.y, maxTextureSize);
+		}
+	}
+}
+
+TEST(TileGrid, nonMultipleOfTileSize) {
+	const NAS2D::TileGrid grid{{2500, 1000}, 1024};
+	EXPECT_EQ((NAS2D::Vector{3, 1}), grid.tileCount());
+
+	EXPECT_EQ((NAS2D::Rectangle<int>{{1024, 0}, {1024, 1000}}), grid.tileBounds({1, 0}));
+	EXPECT_EQ((NAS2D::Rectangle<int>{{2048, 0}, {452, 1000}}), grid.tileBounds({2, 0}));
+
+	EXPECT_EQ((NAS2D::Rectangle<int>{{0, 0}, {1025, 1000}}), grid.textureBounds({0, 0}));
+	EXPECT_EQ((NAS2D::Rectangle<int>{{1023, 0}, {1026, 1000}}), grid.textureBounds({1, 0}));
+	EXPECT_EQ((NAS2D::Rectangle<int>{{2047, 0}, {453, 1000}}), grid.textureBounds({2, 0}));
+}
+
+TEST(TileGrid, uvRect) {
+	const NAS2D::TileGrid grid{{2500, 1000}, 1024};
+
+	// Texture coordinates skip the border, so only the tile's own pixels are drawn
+	expectRectEq({{0.0f, 0.0f}, {1024.0f / 1025.0f, 1.0f}}, grid.uvRect({0, 0}));
+	expectRectEq({{1.0f / 1026.0f, 0.0f}, {1024.0f / 1026.0f, 1.0f}}, grid.uvRect({1, 0}));
+	expectRectEq({{1.0f / 453.0f, 0.0f}, {452.0f / 453.0f, 1.0f}}, grid.uvRect({2, 0}));
+}
+
+TEST(TileGrid, singleTile) {
+	const NAS2D::TileGrid grid{{100, 50}, 1024};
+	EXPECT_EQ((NAS2D::Vector{1, 1}), grid.tileCount());
+	EXPECT_EQ((NAS2D::Rectangle<int>{{0, 0}, {100, 50}}), grid.tileBounds({0, 0}));
+	EXPECT_EQ((NAS2D::Rectangle<int>{{0, 0}, {100, 50}}), grid.textureBounds({0, 0}));
+	expectRectEq({{0.0f, 0.0f}, {1.0f, 1.0f}}, grid.uvRect({0, 0}));
+}
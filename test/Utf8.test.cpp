@@ -0,0 +1,56 @@
+#include "NAS2D/Utf8.h"
+
+#include <gtest/gtest.h>
+
+
+TEST(Utf8, decodeUtf8) {
+	const auto decode = [](std::string_view text) {
+		std::size_t position = 0;
+		const auto codepoint = NAS2D::decodeUtf8(text, position);
+		return std::pair{codepoint, position};
+	};
+
+	EXPECT_EQ((std::pair{U'a', std::size_t{1}}), decode("a"));
+	EXPECT_EQ((std::pair{U'é', std::size_t{2}}), decode("\xC3\xA9"));
+	EXPECT_EQ((std::pair{U'€', std::size_t{3}}), decode("\xE2\x82\xAC"));
+	EXPECT_EQ((std::pair{U'\U0001F600', std::size_t{4}}), decode("\xF0\x9F\x98\x80"));
+}
+
+TEST(Utf8, decodeUtf8Malformed) {
+	const auto decode = [](std::string_view text) {
+		std::size_t position = 0;
+		const auto codepoint = NAS2D::decodeUtf8(text, position);
+		return std::pair{codepoint, position};
+	};
+
+	const auto replacement = std::pair{NAS2D::ReplacementCharacter, std::size_t{1}};
+	// Unexpected continuation byte
+	EXPECT_EQ(replacement, decode("\x80"));
+	// Truncated sequence
+	EXPECT_EQ(replacement, decode("\xE2\x82"));
+	// Missing continuation byte
+	EXPECT_EQ(replacement, decode("\xC3" "a"));
+	// Overlong encoding of '/'
+	EXPECT_EQ(replacement, decode("\xC0\xAF"));
+	// UTF-16 surrogate
+	EXPECT_EQ(replacement, decode("\xED\xA0\x80"));
+	// Above U+10FFFF
+	EXPECT_EQ(replacement, decode("\xF4\x90\x80\x80"));
+	// Invalid lead byte
+	EXPECT_EQ(replacement, decode("\xFF"));
+}
+
+TEST(Utf8, utf8ToCodepoints) {
+	EXPECT_EQ(U"", NAS2D::utf8ToCodepoints(""));
+	EXPECT_EQ(U"abc", NAS2D::utf8ToCodepoints("abc"));
+	EXPECT_EQ(U"aé€\U0001F600", NAS2D::utf8ToCodepoints("a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"));
+	EXPECT_EQ(U"�a", NAS2D::utf8ToCodepoints("\xC3" "a"));
+}
+
+TEST(Utf8, Utf8CodepointRange) {
+	std::u32string codepoints;
+	for (const auto codepoint : NAS2D::Utf8CodepointRange{"x\xC3\xA9y"}) {
+		codepoints.push_back(codepoint);
+	}
+	EXPECT_EQ(U"xéy", codepoints);
+}